@@ -376,24 +376,7 @@ auto	Matrix4x4F::GetPositionFromModelMatrix(const Matrix4x4F& value) -> Vector3F
 
 auto	Matrix4x4F::ToString() const -> std::string
 {
-	std::string res = "Matrix4x4F | \n\t";
-
-	unsigned int	benchmark = 0u;
-
-	for (unsigned int i = 0; i < 16; ++i)
-	{
-
-		res += " " + std::to_string(_values[i]) + " ";
-		++benchmark;
-
-		if (benchmark == 4)
-		{
-			res += "|\n\t   |";
-			benchmark = 0u;
-		}
-	}
-
-	return res;
+	return MStringFormat::ToStdString(*this);
 }
 
 
@@ -71,4 +71,23 @@ private:
 	float	_values[16];
 };
 
+template<>
+struct MFormatter<Matrix4x4F>
+{
+private:
+	//One row per line
+	static auto	format()
+	{
+		return MFORMAT("Matrix4x4F | \n\t"
+			" {}  {}  {}  {} |\n\t   |"
+			" {}  {}  {}  {} |\n\t   |"
+			" {}  {}  {}  {} |\n\t   |"
+			" {}  {}  {}  {} |\n\t   |");
+	}
+
+public:
+	static auto	Length(Matrix4x4F const& value) -> unsigned int { return MStringFormat::Length(format(), value[0], value[1], value[2], value[3], value[4], value[5], value[6], value[7], value[8], value[9], value[10], value[11], value[12], value[13], value[14], value[15]); }
+	static auto	Write(char* out, Matrix4x4F const& value) -> unsigned int { return MStringFormat::Write(out, format(), value[0], value[1], value[2], value[3], value[4], value[5], value[6], value[7], value[8], value[9], value[10], value[11], value[12], value[13], value[14], value[15]); }
+};
+
 #endif /*__MATRIX_HPP__*/
\ No newline at end of file
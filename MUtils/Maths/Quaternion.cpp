@@ -237,7 +237,7 @@ auto	Quaternion::IsNormalized() const -> bool
 
 auto	Quaternion::ToString() const -> std::string
 {
-	return "Quaternion {x: " + std::to_string(X) + ", y: " + std::to_string(Y) + ", z: " + std::to_string(Z) + ", w: " + std::to_string(W) + "}";
+	return MStringFormat::ToStdString(*this);
 }
 
 auto	Quaternion::GetEulerAngles() const -> Vector3F
@@ -60,4 +60,15 @@ private:
 	auto	getMagnitude() const -> float;	
 };
 
+template<>
+struct MFormatter<Quaternion>
+{
+private:
+	static auto	format() { return MFORMAT("Quaternion {{x: {}, y: {}, z: {}, w: {}}}"); }
+
+public:
+	static auto	Length(Quaternion const& value) -> unsigned int { return MStringFormat::Length(format(), value.X, value.Y, value.Z, value.W); }
+	static auto	Write(char* out, Quaternion const& value) -> unsigned int { return MStringFormat::Write(out, format(), value.X, value.Y, value.Z, value.W); }
+};
+
 #endif /*__QUATERNION_HPP__*/
@@ -83,7 +83,7 @@ auto	Vector4F::Dot(const Vector4F& v) const -> float
 
 auto	Vector4F::ToString() const-> std::string
 {
-	return "Vector4F {x: " + std::to_string(x) + ", y: " + std::to_string(y) + ", z: " + std::to_string(z) + ", w: " + std::to_string(w) + "}";
+	return MStringFormat::ToStdString(*this);
 }
 
 
@@ -262,7 +262,7 @@ auto	Vector3F::Lerp(Vector3F const& first, Vector3F const& second, float const&
 
 auto	Vector3F::ToString() const -> std::string
 {
-	return "Vector3F {x: " + std::to_string(x) + ", y: " + std::to_string(y) + ", z: " + std::to_string(z) + "}";
+	return MStringFormat::ToStdString(*this);
 }
 
 auto	Vector3F::ToVector2F() const -> Vector2F
@@ -394,7 +394,7 @@ auto	Vector2F::Angle(const Vector2F& v1, const Vector2F& v2) -> float
 
 auto	Vector2F::ToString() const -> std::string
 {
-	return "Vector2F {x: " + std::to_string(x) + ", y: " + std::to_string(y) + "}";
+	return MStringFormat::ToStdString(*this);
 }
 
 
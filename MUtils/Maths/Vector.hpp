@@ -3,6 +3,8 @@
 
 #include <string>
 
+#include "../Strings/StringFormat.hpp"
+
 class Vector2F
 {
 public:
@@ -134,4 +136,37 @@ public:
 	float	w = 0.0f;
 };
 
+template<>
+struct MFormatter<Vector2F>
+{
+private:
+	static auto	format() { return MFORMAT("Vector2F {{x: {}, y: {}}}"); }
+
+public:
+	static auto	Length(Vector2F const& value) -> unsigned int { return MStringFormat::Length(format(), value.x, value.y); }
+	static auto	Write(char* out, Vector2F const& value) -> unsigned int { return MStringFormat::Write(out, format(), value.x, value.y); }
+};
+
+template<>
+struct MFormatter<Vector3F>
+{
+private:
+	static auto	format() { return MFORMAT("Vector3F {{x: {}, y: {}, z: {}}}"); }
+
+public:
+	static auto	Length(Vector3F const& value) -> unsigned int { return MStringFormat::Length(format(), value.x, value.y, value.z); }
+	static auto	Write(char* out, Vector3F const& value) -> unsigned int { return MStringFormat::Write(out, format(), value.x, value.y, value.z); }
+};
+
+template<>
+struct MFormatter<Vector4F>
+{
+private:
+	static auto	format() { return MFORMAT("Vector4F {{x: {}, y: {}, z: {}, w: {}}}"); }
+
+public:
+	static auto	Length(Vector4F const& value) -> unsigned int { return MStringFormat::Length(format(), value.x, value.y, value.z, value.w); }
+	static auto	Write(char* out, Vector4F const& value) -> unsigned int { return MStringFormat::Write(out, format(), value.x, value.y, value.z, value.w); }
+};
+
 #endif /*__VECTOR_HPP__*/
\ No newline at end of file
@@ -2,104 +2,148 @@
 #define __MSTRING_HPP__
 
 #include <string>
+#include <atomic>
+#include <cstring>
 #include <cwchar>
+#include <initializer_list>
 #include <stdlib.h>
-#include <codecvt>
+
+#include "Strings/StringAllocator.hpp"
+#include "Strings/StringConcat.hpp"
+#include "Strings/StringFormat.hpp"
+#include "Strings/StringUTF.hpp"
+#include "Strings/StringView.hpp"
 
 class MString
 {
 
 public:
-	MString(bool empty = false)
-	{
-		if (empty)
-			return;
-		string = new char;
-		*string = '\0';
-	}
+	//Strings up to LocalCapacity chars are stored inside the object, longer ones go to the heap
+	static const unsigned int	LocalCapacity = 23;
+
+	MString(bool empty = false) { (void)empty; }
 
 	MString(const char* other) { copy(other); }
 	MString(const char* other, unsigned int length) { copy(other, length); }
 	MString(const MString& other) { copy(other); }
+	explicit MString(MStringView other) { copy(other); }
+	MString(MString&& other) { steal(other); }
+
+	//Buffers that do not fit inside the object come from allocator, which must outlive the string.
+	//Copy constructions always go back to the heap, assignments keep the allocator of the destination.
+	explicit MString(MStringAllocator* allocator) : allocator(allocator) {}
+	MString(MStringView other, MStringAllocator* allocator) : allocator(allocator) { copy(other); }
 
-	MString(MString&& other)
+	//Builds a + b + ... with a single allocation, from the heap like copy constructions
+	template<class Left, class Right>
+	MString(MStringConcat<Left, Right>&& concat)
 	{
-		string = other.string;
-		other.string = nullptr;
-		count = other.count;
-		other.count = 0;
+		count = concat.Count();
+		allocate(count);
+		concat.Write(string);
+		string[count] = '\0';
 	}
 
 	~MString()
 	{
-		if (string != nullptr)
-		{
-			delete string;
-			string = nullptr;
-		}
+		release();
 		count = 0;
 	}
 
-	static auto	FromWString(const wchar_t* wideStr) -> MString
+	//Encodes the wide string (UTF-16 or UTF-32 depending on wchar_t) to UTF-8, invalid units become U+FFFD
+	static auto	FromWString(const wchar_t* wideStr) -> MString { return FromWString(wideStr, (unsigned int)wcslen(wideStr)); }
+
+	static auto	FromWString(const wchar_t* wideStr, unsigned int length) -> MString
 	{
 		MString ret(true);
-		ret.count = wcslen(wideStr);
-		ret.string = new char[ret.count + 1];
+		ret.count = MStringUTF::UTF8Length(wideStr, length);
+		ret.allocate(ret.count);
+		MStringUTF::WideToUTF8(wideStr, length, ret.string);
 		ret.string[ret.count] = '\0';
-
-		size_t charsConverted = 0;
-		wcstombs_s(&charsConverted, ret.string, ret.count + 1, wideStr, ret.count);
 		return ret;
 	}
 
-	auto	operator+(const MString& other) const -> MString
+	//Writes the arguments in place of the {} of MFORMAT("..."), sized first so it allocates once
+	template<unsigned int Placeholders, unsigned int LiteralLength, class... Args>
+	static auto	Format(MFormatString<Placeholders, LiteralLength> format, Args const&... args) -> MString
 	{
-		MString	ret = MString(true);
-
-		ret.count = count + other.count;
-		ret.string = new char[ret.count + 1];
-		memcpy(ret.string, string, count);
-		memcpy(ret.string + count, other.string, other.count + 1);
+		MString ret(true);
+		ret.allocate(MStringFormat::Length(format, args...));
+		ret.count = MStringFormat::Write(ret.string, format, args...);
+		ret.string[ret.count] = '\0';
 		return ret;
 	}
 
-	auto	operator+(const char charValue) const -> MString
+	//parts is any range of values convertible to MStringView, the result is allocated once
+	template<class Range>
+	static auto	Join(Range const& parts, MStringView sep) -> MString
 	{
-		MString	ret = MString(true);
-
-		ret.count = count + 1;
-		ret.string = new char[ret.count + 1];
-		memcpy(ret.string, string, count);
-		ret[count] = charValue;
-		ret[count + 1] = '\0';
+		unsigned int	total = 0;
+		unsigned int	partCount = 0;
+		for (auto const& part : parts)
+		{
+			total += MStringView(part).Count();
+			++partCount;
+		}
+		MString ret(true);
+		ret.count = partCount ? total + (partCount - 1) * sep.Count() : 0;
+		ret.allocate(ret.count);
+		char*	out = ret.string;
+		bool	first = true;
+		for (auto const& part : parts)
+		{
+			MStringView view(part);
+			if (!first)
+			{
+				memcpy(out, sep.Data(), sep.Count());
+				out += sep.Count();
+			}
+			memcpy(out, view.Data(), view.Count());
+			out += view.Count();
+			first = false;
+		}
+		ret.string[ret.count] = '\0';
 		return ret;
 	}
 
-	auto	operator+(const char* other) const -> MString
-	{
-		MString	ret = MString(true);
+	static auto	Join(std::initializer_list<MStringView> parts, MStringView sep) -> MString { return Join<std::initializer_list<MStringView>>(parts, sep); }
 
-		size_t len = strlen(other);
+	//a + b + c is a MStringConcat, the result is only written once it is assigned or converted to MString.
+	//A temporary or moved left operand appends to its own buffer instead: std::move(str) + other.
+	auto	operator+(MStringView other) const& -> MStringConcat<MStringPiece, MStringPiece> { return { MStringView(*this), other }; }
+	auto	operator+(char other) const& -> MStringConcat<MStringPiece, MStringPiece> { return { MStringView(*this), other }; }
 
-		ret.count = (unsigned int)len + count;
-		ret.string = new char[ret.count + 1];
-		memcpy(ret.string, string, count);
-		memcpy(ret.string + count, other, len + 1);
-		return ret;
+	template<class Left, class Right>
+	auto	operator+(MStringConcat<Left, Right>&& other) const& -> MStringConcat<MStringPiece, MStringConcat<Left, Right>>
+	{
+		return { MStringView(*this), other };
 	}
 
-	friend MString	operator+(const char* value, MString const& other)
+	auto	operator+(MStringView other) && -> MString
 	{
-		return MString(value) + other;
+		Append(other);
+		return std::move(*this);
 	}
 
-	auto	operator+=(MString const& other) -> MString&
+	auto	operator+(char other) && -> MString
 	{
 		Append(other);
-		return *this;
+		return std::move(*this);
 	}
 
-	auto	operator+=(const char* other) -> MString&
+	template<class Left, class Right>
+	auto	operator+(MStringConcat<Left, Right>&& other) && -> MString
+	{
+		*this += std::move(other);
+		return std::move(*this);
+	}
+
+	friend auto	operator+(const char* value, MString const& other) -> MStringConcat<MStringPiece, MStringPiece>
+	{
+		return { MStringView(value), MStringView(other) };
+	}
+
+	auto	operator+=(MStringView other) -> MString&
 	{
 		Append(other);
 		return *this;
@@ -111,104 +155,199 @@ public:
 		return *this;
 	}
 
+	//Operands may be views of this string
+	template<class Left, class Right>
+	auto	operator+=(MStringConcat<Left, Right>&& other) -> MString&
+	{
+		appendConcat(other, false);
+		return *this;
+	}
+
 	auto	operator=(const char* other) -> MString&
 	{
-		delete string;
-		copy(other);
+		splice(0, count, other, (unsigned int)strlen(other));
 		return *this;
 	}
 
 	auto	operator=(const MString& other) -> MString&
 	{
-		delete string;
-		copy(other);
+		if (this == &other)
+			return *this;
+		if (canShare(other))
+		{
+			release();
+			share(other);
+		}
+		else
+			splice(0, count, other.string, other.count);
+		return *this;
+	}
+
+	//str = str + ... appends in place, otherwise the buffer is reused when it is large enough and no operand points into it
+	template<class Left, class Right>
+	auto	operator=(MStringConcat<Left, Right>&& other) -> MString&
+	{
+		if (other.First().Data() == string && other.First().Count() == count)
+		{
+			appendConcat(other, true);
+			return *this;
+		}
+		unsigned int size = other.Count();
+		if (other.Overlaps(string, string + count + 1))
+		{
+			MString built(allocator);
+			built.allocate(size);
+			built.count = size;
+			other.Write(built.string);
+			built.string[size] = '\0';
+			return *this = std::move(built);
+		}
+		if (size > capacity || IsShared())
+		{
+			release();
+			allocate(size);
+		}
+		resetHash();
+		count = size;
+		other.Write(string);
+		string[count] = '\0';
 		return *this;
 	}
 
 	auto	operator=(MString&& other) -> MString&
 	{
-		delete string;
-		string = other.string;
-		other.string = nullptr;
-		count = other.count;
-		other.count = 0;
+		if (this == &other)
+			return *this;
+		if (allocator != other.allocator)
+			return *this = other;
+		release();
+		steal(other);
 		return *this;
 	}
 
-	auto	operator[](unsigned int idx) -> char& { return string[idx]; }
+	//Writing through the returned reference is a mutation, a shared buffer is detached first
+	auto	operator[](unsigned int idx) -> char&
+	{
+		modified();
+		return string[idx];
+	}
+	auto	operator[](unsigned int idx) const -> char const& { return string[idx]; }
+
+	operator MStringView() const { return MStringView(string, count); }
+#ifdef MSTRING_HAS_STRING_VIEW
+	operator std::string_view() const { return std::string_view(string, count); }
+#endif
+
+	auto	Contains(MStringView sub) const -> bool { return MStringView(*this).Contains(sub); }
+	auto	Find(MStringView sub, unsigned int from = 0) const -> unsigned int { return MStringView(*this).Find(sub, from); }
+	auto	Find(char value, unsigned int from = 0) const -> unsigned int { return MStringView(*this).Find(value, from); }
+	auto	RFind(MStringView sub, unsigned int before = MStringView::Npos) const -> unsigned int { return MStringView(*this).RFind(sub, before); }
+	auto	FindAny(MStringView chars, unsigned int from = 0) const -> unsigned int { return MStringView(*this).FindAny(chars, from); }
+	//Number of non overlapping occurrences of sub, Count() without argument is the length
+	auto	Count(MStringView sub) const -> unsigned int { return MStringView(*this).Count(sub); }
+	auto	Substr(unsigned int idx, unsigned int length = MStringView::Npos) const -> MStringView { return MStringView(*this).Substr(idx, length); }
+
+	auto	Append(MStringView other) -> void { splice(count, 0, other.Data(), other.Count()); }
+	auto	Append(char other) -> void
+	{
+		if (count == capacity)
+			reallocate(grownCapacity(count + 1));
+		modified();
+		string[count++] = other;
+		string[count] = '\0';
+	}
 
-	auto	Contains(MString const& sub) -> bool { return strstr(string, sub.string) != nullptr; }
-	auto	Contains(char* const sub) const -> bool { return strstr(string, sub) != nullptr; }
+	auto	AppendInt(long long value) -> void
+	{
+		Reserve(count + MStringNumber::MaxIntChars);
+		modified();
+		count += MStringNumber::FormatInt(string + count, value);
+		string[count] = '\0';
+	}
 
-	auto	Append(MString const& other) -> void
+	auto	AppendUInt(unsigned long long value) -> void
 	{
-		char* temp = new char[count + other.count + 1];
-		memcpy(temp, string, count);
-		memcpy(temp + count, other.string, other.count + 1);
-		delete string;
-		string = temp;
-		count = count + other.count;
+		Reserve(count + MStringNumber::MaxIntChars);
+		modified();
+		count += MStringNumber::FormatUInt(string + count, value);
+		string[count] = '\0';
 	}
 
-	auto	Append(char* const other) -> void
+	//Shortest text that parses back to the same value
+	auto	AppendFloat(float value) -> void
 	{
-		size_t len = strlen(other);
-		char* temp = new char[count + len + 1];
-		memcpy(temp, string, count);
-		memcpy(temp + count, other, len + 1);
-		delete string;
-		string = temp;
-		count = count + (unsigned int)len;
+		Reserve(count + MStringNumber::MaxFloatChars);
+		modified();
+		count += MStringNumber::FormatFloat(string + count, value);
+		string[count] = '\0';
 	}
 
-	auto	Append(char other) -> void
+	//Arguments may be views of this string
+	template<unsigned int Placeholders, unsigned int LiteralLength, class... Args>
+	auto	AppendFormat(MFormatString<Placeholders, LiteralLength> format, Args const&... args) -> void
 	{
-		char* temp = new char[count + 1 + 1];
-		memcpy(temp, string, count);
-		temp[count] = other;
-		temp[count + 1] = '\0';
-		delete string;
-		string = temp;
-		count += 1;
+		unsigned int size = count + MStringFormat::Length(format, args...);
+		if (size > capacity)
+		{
+			//Written next to the current buffer, which is only released once the arguments are read
+			MString grown(allocator);
+			grown.allocate(grownCapacity(size));
+			memcpy(grown.string, string, count);
+			grown.count = count + MStringFormat::Write(grown.string + count, format, args...);
+			grown.string[grown.count] = '\0';
+			*this = std::move(grown);
+			return;
+		}
+		modified();
+		count += MStringFormat::Write(string + count, format, args...);
+		string[count] = '\0';
 	}
 
+	auto	ParseInt(long long& value) const -> unsigned int { return MStringView(*this).ParseInt(value); }
+	auto	ParseInt(int& value) const -> unsigned int { return MStringView(*this).ParseInt(value); }
+	auto	ParseUInt(unsigned long long& value) const -> unsigned int { return MStringView(*this).ParseUInt(value); }
+	auto	ParseUInt(unsigned int& value) const -> unsigned int { return MStringView(*this).ParseUInt(value); }
+	auto	ParseFloat(float& value) const -> unsigned int { return MStringView(*this).ParseFloat(value); }
+
+	//Keeps the current capacity, call ShrinkToFit to give the memory back
 	auto	Empty() -> void 
 	{
-		if (!string)
-			return;
-		delete string;
-		string = new char;
-		*string = '\0';
+		if (IsShared())
+			release();
+		modified();
 		count = 0;
+		string[0] = '\0';
 	}
 
-	auto	InsertAt(unsigned int idx, char* const other) -> void
+	auto	Reserve(unsigned int size) -> void
 	{
-		if (idx > count)
-			return;
-		size_t len = strlen(other);
-		char* temp = new char[count + len + 1];
-		memcpy(temp, string, idx);
-		memcpy(temp + idx, other, len);	
-		memcpy(temp + idx + len, string + idx, count - idx);
-		count += len;
-		delete string;
-		temp[count] = '\0';
-		string = temp;
+		if (size > capacity)
+			reallocate(size);
+	}
+
+	auto	ShrinkToFit() -> void
+	{
+		if (!IsLocal() && capacity > count)
+			reallocate(count);
+	}
+
+	//Sets the length to size and returns the buffer for the caller to write into, the terminator is already there.
+	//The current chars are kept up to size, the ones after are undefined. Grows to exactly size when it does not fit.
+	auto	ResizeForOverwrite(unsigned int size) -> char*
+	{
+		modified();
+		if (size > capacity)
+			reallocate(size);
+		count = size;
+		string[count] = '\0';
+		return string;
 	}
 
-	auto	InsertAt(unsigned int idx, MString const& other) -> void
+	auto	InsertAt(unsigned int idx, MStringView other) -> void
 	{
 		if (idx > count)
 			return;
-		char* temp = new char[count + other.count + 1];
-		memcpy(temp, string, idx);
-		memcpy(temp + idx, other.string, other.count);
-		memcpy(temp + idx + other.count, string + idx, count - idx);
-		count += other.count;
-		delete string;
-		temp[count] = '\0';
-		string = temp;
+		splice(idx, 0, other.Data(), other.Count());
 	}
 
 	auto	ValidIndex(unsigned int idx) -> bool { return string && count > idx; }
@@ -217,72 +356,213 @@ public:
 	{
 		if (idx + size > count)
 			return;
-		char* temp = new char[count - size + 1];
-		memcpy(temp, string, idx);
-		memcpy(temp + idx, string + idx + size, count - idx + size);
-		count -= size;
-		temp[count] = '\0';
-		delete string;
-		string = temp;
+		splice(idx, size, "", 0);
+	}
+
+	//Replaces the first occurrence of from at or after start, returns false when there is none
+	auto	Replace(MStringView from, MStringView to, unsigned int start = 0) -> bool
+	{
+		unsigned int idx = from.Count() ? Find(from, start) : MStringView::Npos;
+		if (idx == MStringView::Npos)
+			return false;
+		splice(idx, from.Count(), to.Data(), to.Count());
+		return true;
 	}
 
-	auto	Split(MString const& sep, MString& left, MString& right) const -> bool
+	//Replaces every non overlapping occurrence of from, scanning left to right, and returns how many there were.
+	//Matches are counted first so the result is built with one allocation, or in place when it does not grow.
+	auto	ReplaceAll(MStringView from, MStringView to) -> unsigned int
 	{
-		char* res = strstr(string, sep.string);
-		if (!res)
+		unsigned int found = Count(from);
+		if (found == 0)
+			return 0;
+		unsigned int newCount = count - found * from.Count() + found * to.Count();
+		resetHash();
+		//Writes never pass the read position when the string does not grow
+		if (to.Count() <= from.Count() && !IsShared() && !aliases(from) && !aliases(to))
+		{
+			count = replaceTo(string, from, to);
+			string[count] = '\0';
+			return found;
+		}
+
+		char	buffer[LocalCapacity + 1];
+		char*	temp = newCount > LocalCapacity ? newBuffer(newCount) : buffer;
+		replaceTo(temp, from, to);
+		release();
+		if (temp == buffer)
+			memcpy(local, buffer, newCount);
+		else
+		{
+			string = temp;
+			capacity = newCount;
+		}
+		count = newCount;
+		string[count] = '\0';
+		return found;
+	}
+
+	//Whitespace trimming in place, see MStringView::Trim
+	auto	TrimStart() -> void
+	{
+		unsigned int length = MStringView(*this).TrimStart().Count();
+		if (length != count)
+			RemoveAt(0, count - length);
+	}
+
+	auto	TrimEnd() -> void
+	{
+		unsigned int length = MStringView(*this).TrimEnd().Count();
+		if (length != count)
+			RemoveAt(length, count - length);
+	}
+
+	auto	Trim() -> void
+	{
+		TrimEnd();
+		TrimStart();
+	}
+
+	auto	Split(MStringView sep, MString& left, MString& right) const -> bool
+	{
+		MStringView	leftView;
+		MStringView	rightView;
+		if (!Split(sep, leftView, rightView))
 			return false;
-		right = MString(res + sep.count);
-		left = MString(string, (unsigned int)(res - string));
+		MString	leftStr(leftView);
+		right = MString(rightView);
+		left = std::move(leftStr);
 		return true;
 	}
 
+	//The views point inside this string and are invalidated by the next edit
+	auto	Split(MStringView sep, MStringView& left, MStringView& right) const -> bool { return MStringView(*this).Split(sep, left, right); }
+	auto	SplitAll(MStringView sep, std::vector<MStringView>& tokens) const -> unsigned int { return MStringView(*this).SplitAll(sep, tokens); }
+	auto	Tokenize(MStringView sep, bool skipEmpty = false) const -> MStringTokenizer { return MStringView(*this).Tokenize(sep, skipEmpty); }
+
+	//Case functions only touch ASCII letters and do not depend on the locale
 	auto	ToLower() const -> MString
 	{
 		MString	ret = *this;
-		for (char* str = ret.string; *str != '\0'; ++str)
-			*str = tolower(*str);
+		ret.ToLowerInPlace();
 		return ret;
 	}
 
 	auto	ToUpper() const -> MString
 	{
 		MString ret = *this;
-		for (char* str = ret.string; *str != '\0'; ++str)
-			*str = toupper(*str);
+		ret.ToUpperInPlace();
+		return ret;
+	}
+
+	auto	ToLowerInPlace() -> void
+	{
+		modified();
+		MStringCase::ToLower(string, count);
+	}
+
+	auto	ToUpperInPlace() -> void
+	{
+		modified();
+		MStringCase::ToUpper(string, count);
+	}
+
+	auto	Repeat(unsigned int times) const -> MString
+	{
+		MString ret(allocator);
+		ret.count = count * times;
+		ret.allocate(ret.count);
+		if (ret.count)
+		{
+			//Doubles the copied part, so log2(times) copies
+			memcpy(ret.string, string, count);
+			for (unsigned int done = count; done < ret.count; done *= 2)
+				memcpy(ret.string + done, ret.string, done * 2 <= ret.count ? done : ret.count - done);
+		}
+		ret.string[ret.count] = '\0';
 		return ret;
 	}
 
+	auto	EqualsIgnoreCase(MStringView other) const -> bool { return MStringView(*this).EqualsIgnoreCase(other); }
+	auto	CompareIgnoreCase(MStringView other) const -> int { return MStringView(*this).CompareIgnoreCase(other); }
+	auto	FindIgnoreCase(MStringView sub, unsigned int from = 0) const -> unsigned int { return MStringView(*this).FindIgnoreCase(sub, from); }
+	auto	ContainsIgnoreCase(MStringView sub) const -> bool { return MStringView(*this).ContainsIgnoreCase(sub); }
+
+	//Unicode simple case folding of the UTF-8 content, unlike ToLower it also handles non ASCII letters
+	auto	FoldCase() const -> MString
+	{
+		MString ret(true);
+		ret.count = MStringFold::FoldedLength(string, count);
+		ret.allocate(ret.count);
+		MStringFold::FoldTo(string, count, ret.string);
+		ret.string[ret.count] = '\0';
+		return ret;
+	}
+
+	auto	EqualsFolded(MStringView other) const -> bool { return MStringView(*this).EqualsFolded(other); }
+	auto	HashFolded() const -> unsigned long long { return MStringView(*this).HashFolded(); }
+
 	static MString FromInt(int const& value)
 	{
-		char buffer[50];
-		int n = 0;
-		n = sprintf_s(buffer, 50, "%d", value);
-		return MString(buffer, n);
+		MString result;
+		result.AppendInt(value);
+		return result;
 	}
 
 	static MString FromUInt(unsigned int const& value)
 	{
-		char buffer[50];
-		int n = 0;
-		n = sprintf_s(buffer, 50,"%d", value);
-		return MString(buffer, n);
+		MString result;
+		result.AppendUInt(value);
+		return result;
 	}
 
 	static MString FromFloat(float const& value)
 	{
-		char buffer[50];
-		int n = 0;
-		n = sprintf_s(buffer, 50, "%f", value);
-		return MString(buffer, n);
+		MString result;
+		result.AppendFloat(value);
+		return result;
 	}
 
 	auto	Str() const -> char const* { return string; }
 	auto	Count() const -> unsigned int { return count; }
+	auto	Capacity() const -> unsigned int { return capacity; }
+	auto	IsLocal() const -> bool { return string == local; }
+	//True when MSTRING_SHARED_BUFFERS is defined and another MString references the same buffer
+	auto	IsShared() const -> bool
+	{
+#ifdef MSTRING_SHARED_BUFFERS
+		return !IsLocal() && !allocator && header(string)->refs.load(std::memory_order_acquire) > 1;
+#else
+		return false;
+#endif
+	}
+
+	//nullptr when the string uses the heap
+	auto	GetAllocator() const -> MStringAllocator* { return allocator; }
+
+	//Same value as MStringView::Hash, kept until the next mutation when MSTRING_CACHED_HASH is defined.
+	//The cache is written by this const method, hashing a string shared between threads is then not thread safe.
+	auto	Hash() const -> unsigned long long
+	{
+#ifdef MSTRING_CACHED_HASH
+		if (!hashed)
+		{
+			hash = MStringHash::Hash(string, count);
+			hashed = true;
+		}
+		return hash;
+#else
+		return MStringHash::Hash(string, count);
+#endif
+	}
+
+	bool	operator==(MStringView other) const { return MStringSearch::Equal(string, count, other.Data(), other.Count()); }
+	bool	operator!=(MStringView other) const { return !(*this == other); }
 
-	bool	operator==(const MString& other) { return strcmp(string, other.string) == 0; }
-	bool	operator==(char* other) { return strcmp(string, other) == 0; }	
+	friend bool	operator==(const char* first, MString const& second) { return second == first; }
+	friend bool	operator!=(const char* first, MString const& second) { return second != first; }
 
-	bool	operator <(const MString& other) const { return strcmp(string, other.string) < 0; }
+	bool	operator <(MStringView other) const { return MStringSearch::Compare(string, count, other.Data(), other.Count()) < 0; }
 
 	//ITERATOR SHIT
 
@@ -291,30 +571,338 @@ protected:
 private:
 	auto	copy(const char* other) -> void
 	{
-		size_t size = strlen(other);
-		string = new char[size + 1];
+		unsigned int size = (unsigned int)strlen(other);
+		allocate(size);
 		memcpy(string, other, size + 1);
 		count = size;
 	}
 
 	auto	copy(MString const& other) -> void
 	{
+		if (canShare(other))
+		{
+			share(other);
+			return;
+		}
+		allocate(other.count);
 		count = other.count;
-		string = new char[count + 1];
 		memcpy(string, other.string, count + 1);
 	}
 
+	auto	copy(MStringView other) -> void
+	{
+		allocate(other.Count());
+		count = other.Count();
+		memcpy(string, other.Data(), count);
+		string[count] = '\0';
+	}
+
 	auto	copy(const char* other, unsigned int length) -> void
 	{
 		size_t otherLen = strlen(other);
- 		count = length > otherLen ? otherLen: length;
-		string = new char[count + 1];
+		count = length > otherLen ? (unsigned int)otherLen : length;
+		allocate(count);
 		memcpy(string, other, count);
 		string[count] = '\0';
 	}
 
-	char*			string = nullptr;
-	unsigned int	count = 0;
+	//Points string at a buffer able to hold size chars plus the terminator, the content is left undefined
+	auto	allocate(unsigned int size) -> void
+	{
+		if (size <= LocalCapacity)
+			return;
+		string = newBuffer(size);
+		capacity = size;
+	}
+
+	auto	release() -> void
+	{
+		if (!IsLocal())
+			deleteBuffer(string, capacity);
+		string = local;
+		capacity = LocalCapacity;
+	}
+
+	//Moves the content to a buffer of exactly newCapacity chars, or back inside the object when it fits
+	auto	reallocate(unsigned int newCapacity) -> void
+	{
+		if (newCapacity <= LocalCapacity)
+		{
+			if (IsLocal())
+				return;
+			memcpy(local, string, count + 1);
+			release();
+			return;
+		}
+		if (growInPlace(newCapacity))
+			return;
+		char* temp = newBuffer(newCapacity);
+		memcpy(temp, string, count + 1);
+		release();
+		string = temp;
+		capacity = newCapacity;
+	}
+
+#ifdef MSTRING_SHARED_BUFFERS
+	//Heap buffers are preceded by their reference count, allocator buffers are never shared
+	struct SharedHeader
+	{
+		std::atomic<unsigned int>	refs;
+	};
+
+	static auto	header(char* buffer) -> SharedHeader* { return reinterpret_cast<SharedHeader*>(buffer) - 1; }
+#endif
+
+	auto	newBuffer(unsigned int size) -> char*
+	{
+		if (allocator)
+			return allocator->Allocate(size + 1);
+#ifdef MSTRING_SHARED_BUFFERS
+		SharedHeader* shared = reinterpret_cast<SharedHeader*>(new char[sizeof(SharedHeader) + size + 1]);
+		shared->refs.store(1, std::memory_order_relaxed);
+		return reinterpret_cast<char*>(shared + 1);
+#else
+		return new char[size + 1];
+#endif
+	}
+
+	auto	deleteBuffer(char* buffer, unsigned int size) -> void
+	{
+		if (allocator)
+			allocator->Deallocate(buffer, size + 1);
+#ifdef MSTRING_SHARED_BUFFERS
+		else if (header(buffer)->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+			delete[] reinterpret_cast<char*>(header(buffer));
+#else
+		else
+			delete[] buffer;
+#endif
+	}
+
+	auto	canShare(MString const& other) const -> bool
+	{
+#ifdef MSTRING_SHARED_BUFFERS
+		return !allocator && !other.allocator && !other.IsLocal();
+#else
+		(void)other;
+		return false;
+#endif
+	}
+
+	//Points at the buffer of other, the caller released the previous one. The cached hash comes along with the content.
+	auto	share(MString const& other) -> void
+	{
+#ifdef MSTRING_SHARED_BUFFERS
+		header(other.string)->refs.fetch_add(1, std::memory_order_relaxed);
+		string = other.string;
+		count = other.count;
+		capacity = other.capacity;
+#ifdef MSTRING_CACHED_HASH
+		hash = other.hash;
+		hashed = other.hashed;
+#endif
+#else
+		(void)other;
+#endif
+	}
+
+	//Gives this string its own copy of a shared buffer before it is written in place
+	auto	detach() -> void
+	{
+		if (IsShared())
+			reallocate(capacity);
+	}
+
+	//Only allocators can resize a heap buffer without moving it
+	auto	growInPlace(unsigned int newCapacity) -> bool
+	{
+		if (!allocator || IsLocal() || newCapacity <= LocalCapacity || !allocator->Resize(string, capacity + 1, newCapacity + 1))
+			return false;
+		capacity = newCapacity;
+		return true;
+	}
+
+	auto	grownCapacity(unsigned int size) const -> unsigned int
+	{
+		unsigned int grown = capacity * 2;
+		return grown > size ? grown : size;
+	}
+
+	auto	steal(MString& other) -> void
+	{
+		if (other.IsLocal())
+		{
+			memcpy(local, other.local, other.count + 1);
+			string = local;
+		}
+		else
+			string = other.string;
+		count = other.count;
+		capacity = other.capacity;
+		allocator = other.allocator;
+#ifdef MSTRING_CACHED_HASH
+		hash = other.hash;
+		hashed = other.hashed;
+		other.hashed = false;
+#endif
+		other.string = other.local;
+		other.count = 0;
+		other.capacity = LocalCapacity;
+		other.local[0] = '\0';
+	}
+
+	//Replaces the removed chars at idx by the len chars of src, editing in place when the result fits the current capacity
+	auto	splice(unsigned int idx, unsigned int removed, const char* src, unsigned int len) -> void
+	{
+		resetHash();
+		unsigned int	newCount = count - removed + len;
+		//A shared buffer is never edited in place, the other owners keep it
+		bool			aliased = (src < string + count + 1 && src + len > string) || IsShared();
+
+		if (newCount > capacity && !aliased)
+			growInPlace(grownCapacity(newCount));
+		if (newCount <= capacity && !aliased)
+		{
+			memmove(string + idx + len, string + idx + removed, count - idx - removed + 1);
+			memcpy(string + idx, src, len);
+			count = newCount;
+			return;
+		}
+
+		unsigned int	newCapacity = newCount > capacity ? grownCapacity(newCount) : capacity;
+		char			buffer[LocalCapacity + 1];
+		char*			temp = newCapacity > LocalCapacity ? newBuffer(newCapacity) : buffer;
+		memcpy(temp, string, idx);
+		memcpy(temp + idx, src, len);
+		memcpy(temp + idx + len, string + idx + removed, count - idx - removed + 1);
+		release();
+		if (temp == buffer)
+			memcpy(local, buffer, newCount + 1);
+		else
+		{
+			string = temp;
+			capacity = newCapacity;
+		}
+		count = newCount;
+	}
+
+	auto	aliases(MStringView other) const -> bool { return other.Data() < string + count + 1 && other.Data() + other.Count() > string; }
+
+	//Writes the content with every from replaced by to, out may be string itself when to is not longer than from
+	auto	replaceTo(char* out, MStringView from, MStringView to) const -> unsigned int
+	{
+		unsigned int	read = 0;
+		unsigned int	written = 0;
+		for (unsigned int pos = Find(from); pos != MStringView::Npos; pos = Find(from, read))
+		{
+			memmove(out + written, string + read, pos - read);
+			written += pos - read;
+			memcpy(out + written, to.Data(), to.Count());
+			written += to.Count();
+			read = pos + from.Count();
+		}
+		memmove(out + written, string + read, count - read);
+		return written + count - read;
+	}
+
+	auto	modified() -> void
+	{
+		detach();
+		resetHash();
+	}
+
+	auto	resetHash() -> void
+	{
+#ifdef MSTRING_CACHED_HASH
+		hashed = false;
+#endif
+	}
+
+	//Writes the operands after the content, the first one is skipped when it is the content itself.
+	//Operands pointing into the content stay valid: the grown buffer is filled before the current one is released.
+	template<class Concat>
+	auto	appendConcat(Concat const& concat, bool skipFirst) -> void
+	{
+		unsigned int size = skipFirst ? concat.Count() : count + concat.Count();
+		if (size > capacity)
+		{
+			MString grown(allocator);
+			grown.allocate(grownCapacity(size));
+			memcpy(grown.string, string, count);
+			concat.Write(grown.string + count, skipFirst);
+			grown.count = size;
+			grown.string[size] = '\0';
+			*this = std::move(grown);
+			return;
+		}
+		modified();
+		concat.Write(string + count, skipFirst);
+		count = size;
+		string[count] = '\0';
+	}
+
+	char*				string = local;
+	unsigned int		count = 0;
+	unsigned int		capacity = LocalCapacity;
+	MStringAllocator*	allocator = nullptr;
+	char				local[LocalCapacity + 1] = {};
+#ifdef MSTRING_CACHED_HASH
+	mutable unsigned long long	hash = 0;
+	mutable bool				hashed = false;
+#endif
+};
+
+template<class Left, class Right>
+inline auto	MStringConcat<Left, Right>::ToString(MStringAllocator* allocator) && -> MString
+{
+	MString ret(allocator);
+	ret = std::move(*this);
+	return ret;
+}
+
+template<>
+struct MFormatter<MString> : MFormatter<MStringView> {};
+
+namespace std
+{
+	template<>
+	struct hash<MString>
+	{
+		size_t	operator()(MString const& str) const { return (size_t)str.Hash(); }
+	};
+}
+
+//Transparent hasher and equality so containers keyed on MString can be probed with views or C strings
+//without building a temporary MString (heterogeneous lookup needs C++20 unordered containers)
+struct MStringHasher
+{
+	using is_transparent = void;
+
+	size_t	operator()(MString const& str) const { return (size_t)str.Hash(); }
+	size_t	operator()(MStringView str) const { return (size_t)str.Hash(); }
+	size_t	operator()(const char* str) const { return (size_t)MStringView(str).Hash(); }
+};
+
+struct MStringEqual
+{
+	using is_transparent = void;
+
+	bool	operator()(MStringView first, MStringView second) const { return first == second; }
+};
+
+//Same for case insensitive keys, compared and hashed through simple case folding
+struct MStringFoldedHasher
+{
+	using is_transparent = void;
+
+	size_t	operator()(MStringView str) const { return (size_t)str.HashFolded(); }
+};
+
+struct MStringFoldedEqual
+{
+	using is_transparent = void;
+
+	bool	operator()(MStringView first, MStringView second) const { return first.EqualsFolded(second); }
 };
 
 class MWString
@@ -324,7 +912,7 @@ public:
 	{
 		if (empty)
 			return;
-		wstring = new wchar_t;
+		wstring = new wchar_t[1];
 		*wstring = '\0';
 	}
 
@@ -344,7 +932,7 @@ public:
 	{
 		if (wstring != nullptr)
 		{
-			delete wstring;
+			delete[] wstring;
 			wstring = nullptr;
 		}
 		count = 0;
@@ -355,8 +943,8 @@ public:
 		size_t len = wcslen(other);
 		wchar_t* temp = new wchar_t[count + len + 1];
 		memcpy(temp, wstring, count * sizeof(wchar_t));
-		memcpy(temp + count * sizeof(wchar_t), other, (len + 1) * sizeof(wchar_t));
-		delete wstring;
+		memcpy(temp + count, other, (len + 1) * sizeof(wchar_t));
+		delete[] wstring;
 		wstring = temp;
 		count = count + (unsigned int)len;
 	}
@@ -367,7 +955,7 @@ public:
 		memcpy(temp, wstring, count * sizeof(wchar_t));
 		temp[count] = other;
 		temp[count + 1] = L'\0';
-		delete wstring;
+		delete[] wstring;
 		wstring = temp;
 		count += 1;
 	}
@@ -376,27 +964,26 @@ public:
 	{
 		if (count == 0)
 			return MString();
-		std::wstring_convert<std::codecvt_utf8<wchar_t>> conv;
-		return MString(conv.to_bytes(wstring).c_str());
+		return MString::FromWString(wstring, count);
 	}
 
 	auto	operator=(const wchar_t* other) -> MWString&
 	{
-		delete wstring;
+		delete[] wstring;
 		copy(other);
 		return *this;
 	}
 
 	auto	operator=(const MWString& other) -> MWString&
 	{
-		delete wstring;
+		delete[] wstring;
 		copy(other);
 		return *this;
 	}
 
 	auto	operator=(MWString&& other) -> MWString&
 	{
-		delete wstring;
+		delete[] wstring;
 		wstring = other.wstring;
 		other.wstring = nullptr;
 		count = other.count;
@@ -406,24 +993,22 @@ public:
 	
 	auto	operator[](unsigned int idx) -> wchar_t& { return wstring[idx]; }
 
-	static auto FromUTF8(const char* str) -> MWString
-	{
-		std::wstring_convert<std::codecvt_utf8_utf16<wchar_t>, wchar_t> utf16conv;
-		return MWString(utf16conv.from_bytes(str).c_str());
-	}
+	static auto FromUTF8(const char* str) -> MWString { return FromUTF8(MStringView(str)); }
 
-	static auto	FromString(MString const& string) -> MWString
+	//Decodes UTF-8 to UTF-16 or UTF-32 depending on wchar_t, ill formed sequences become U+FFFD
+	static auto	FromUTF8(MStringView str) -> MWString
 	{
 		MWString	ret(true);
-		ret.wstring = new wchar_t[string.Count() + 1];
-		size_t sizePtr;
-		mbstowcs_s(&sizePtr, ret.wstring, string.Count() + 1, string.Str(), string.Count() + 1);
-		//mbstowcs(ret.wstring, string.Str(), string.Count() + 1);
-		ret.count = string.Count();
-		ret.wstring[ret.count] = '\0';
+		ret.count = MStringUTF::WideLength(str.Data(), str.Count());
+		ret.wstring = new wchar_t[ret.count + 1];
+		MStringUTF::UTF8ToWide(str.Data(), str.Count(), ret.wstring);
+		ret.wstring[ret.count] = L'\0';
 		return ret;
 	}
 
+	//MString content is UTF-8
+	static auto	FromString(MString const& string) -> MWString { return FromUTF8(MStringView(string)); }
+
 	auto	Str() const -> wchar_t* { return wstring; }
 	auto	Count() const -> unsigned int { return count; }
 
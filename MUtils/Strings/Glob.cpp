@@ -0,0 +1,442 @@
+#include "Glob.hpp"
+
+#include <algorithm>
+#include <map>
+
+auto	MGlob::Compile(MStringView text) -> void
+{
+	pattern = MString(text);
+	tokens.clear();
+	classes.clear();
+	char const*		data = pattern.Str();
+	unsigned int	count = pattern.Count();
+	unsigned int	pos = 0;
+	while (pos < count)
+	{
+		char c = data[pos];
+		if (c == '*')
+		{
+			unsigned int end = pos;
+			while (end < count && data[end] == '*')
+				++end;
+			bool segmentStart = pos == 0 || data[pos - 1] == '/';
+			if (end - pos == 1)
+				tokens.push_back(Token{ Star, 0, 0 });
+			else if (segmentStart && end < count && data[end] == '/')
+			{
+				//The slash belongs to the wildcard so zero directories match too
+				tokens.push_back(Token{ GlobSegments, 0, 0 });
+				++end;
+			}
+			else
+				tokens.push_back(Token{ GlobAny, 0, 0 });
+			pos = end;
+			continue;
+		}
+		if (c == '?')
+		{
+			tokens.push_back(Token{ AnyChar, 0, 0 });
+			++pos;
+			continue;
+		}
+		if (c == '[')
+		{
+			unsigned int end = parseClass(pos);
+			if (end != pos)
+			{
+				pos = end;
+				continue;
+			}
+		}
+		//Literal run, a '[' without its ']' included
+		if (!tokens.empty() && tokens.back().kind == Literal && tokens.back().offset + tokens.back().length == pos)
+			++tokens.back().length;
+		else
+			tokens.push_back(Token{ Literal, pos, 1 });
+		++pos;
+	}
+
+	tokenBegin = 0;
+	tokenEnd = (unsigned int)tokens.size();
+	prefixLength = 0;
+	suffixOffset = 0;
+	suffixLength = 0;
+	if (tokenBegin < tokenEnd && tokens[tokenBegin].kind == Literal)
+		prefixLength = tokens[tokenBegin++].length;
+	if (tokenBegin < tokenEnd && tokens[tokenEnd - 1].kind == Literal)
+	{
+		suffixOffset = tokens[tokenEnd - 1].offset;
+		suffixLength = tokens[--tokenEnd].length;
+	}
+	minLength = 0;
+	for (Token const& token : tokens)
+		minLength += token.kind == Literal ? token.length : token.kind == AnyChar || token.kind == Class ? 1 : 0;
+	lastChar = !tokens.empty() && tokens.back().kind == Literal ? (unsigned char)data[tokens.back().offset + tokens.back().length - 1] : -1;
+}
+
+//Reads the class starting with the '[' at pos, returns the position after its ']' or pos when it is not closed
+auto	MGlob::parseClass(unsigned int pos) -> unsigned int
+{
+	char const*		data = pattern.Str();
+	unsigned int	count = pattern.Count();
+	unsigned int	idx = pos + 1;
+	bool			negated = idx < count && (data[idx] == '!' || data[idx] == '^');
+	if (negated)
+		++idx;
+	CharClass		chars = {};
+	//A ']' right after the opening bracket is part of the class
+	for (bool first = true; idx < count && (first || data[idx] != ']'); first = false)
+	{
+		unsigned char low = (unsigned char)data[idx];
+		unsigned char high = low;
+		if (idx + 2 < count && data[idx + 1] == '-' && data[idx + 2] != ']')
+		{
+			high = (unsigned char)data[idx + 2];
+			idx += 3;
+		}
+		else
+			++idx;
+		for (unsigned int c = low; c <= high; ++c)
+			chars.bits[c >> 5] |= 1u << (c & 31);
+	}
+	if (idx >= count)
+		return pos;
+	if (negated)
+	{
+		for (unsigned int& bits : chars.bits)
+			bits = ~bits;
+	}
+	chars.bits['/' >> 5] &= ~(1u << ('/' & 31));
+	tokens.push_back(Token{ Class, (unsigned int)classes.size(), 0 });
+	classes.push_back(chars);
+	return idx + 1;
+}
+
+//Walks the tokens left to right. On a mismatch the last * takes one more char, when it cannot (a '/' or the end)
+//the last ** moves on instead, by one char or to the next directory. An earlier wildcard never has to grow since
+//the later one can take whatever it would have.
+auto	MGlob::matchTokens(char const* text, unsigned int count) const -> bool
+{
+	static const unsigned int	None = 0xFFFFFFFF;
+
+	//Shortcut for the common *.ext once the suffix is checked
+	if (tokenEnd - tokenBegin == 1 && tokens[tokenBegin].kind == Star)
+		return count == 0 || memchr(text, '/', count) == nullptr;
+
+	unsigned int	tok = tokenBegin;
+	unsigned int	pos = 0;
+	unsigned int	starTok = None;
+	unsigned int	starPos = 0;
+	unsigned int	globTok = None;
+	unsigned int	globPos = 0;
+	for (;;)
+	{
+		if (tok == tokenEnd)
+		{
+			if (pos == count)
+				return true;
+		}
+		else
+		{
+			Token const& token = tokens[tok];
+			switch (token.kind)
+			{
+			case Literal:
+				if (count - pos >= token.length && memcmp(text + pos, pattern.Str() + token.offset, token.length) == 0)
+				{
+					pos += token.length;
+					++tok;
+					continue;
+				}
+				break;
+			case AnyChar:
+				if (pos < count && text[pos] != '/')
+				{
+					++pos;
+					++tok;
+					continue;
+				}
+				break;
+			case Class:
+				if (pos < count && (classes[token.offset].bits[(unsigned char)text[pos] >> 5] >> ((unsigned char)text[pos] & 31) & 1) != 0)
+				{
+					++pos;
+					++tok;
+					continue;
+				}
+				break;
+			case Star:
+				starTok = tok++;
+				starPos = pos;
+				continue;
+			case GlobAny:
+			case GlobSegments:
+				globTok = tok++;
+				globPos = pos;
+				starTok = None;
+				continue;
+			}
+		}
+
+		if (starTok != None && starPos < count && text[starPos] != '/')
+		{
+			pos = ++starPos;
+			tok = starTok + 1;
+			continue;
+		}
+		starTok = None;
+		if (globTok == None || globPos >= count)
+			return false;
+		if (tokens[globTok].kind == GlobAny)
+			++globPos;
+		else
+		{
+			void const* slash = memchr(text + globPos, '/', count - globPos);
+			if (!slash)
+				return false;
+			globPos = (unsigned int)((char const*)slash - text) + 1;
+		}
+		pos = globPos;
+		tok = globTok + 1;
+	}
+}
+
+//Every token becomes states pointing at the state after them, so a rule is laid out from its first state
+//to its Accept and a state only moves without reading to a later one
+auto	MGlobSet::Add(MStringView pattern) -> unsigned int
+{
+	unsigned int	id = (unsigned int)globs.size();
+	transitions.clear();
+	globs.emplace_back(pattern);
+	MGlob const&	glob = globs.back();
+	unsigned int	first = (unsigned int)states.size();
+	for (MGlob::Token const& token : glob.tokens)
+	{
+		unsigned int following = (unsigned int)states.size() + 1;
+		switch (token.kind)
+		{
+		case MGlob::Literal:
+			for (unsigned int idx = 0; idx < token.length; ++idx)
+				addState(Byte, (unsigned char)glob.pattern.Str()[token.offset + idx], (unsigned int)states.size() + 1, None);
+			break;
+		case MGlob::AnyChar:
+			addState(NotSlash, 0, following, None);
+			break;
+		case MGlob::Class:
+			addState(Class, (unsigned int)classes.size(), following, None);
+			classes.push_back(glob.classes[token.offset]);
+			break;
+		case MGlob::Star:
+			addState(NotSlash, 0, following - 1, following);
+			break;
+		case MGlob::GlobAny:
+			addState(Any, 0, following - 1, following);
+			break;
+		case MGlob::GlobSegments:
+			//Nothing, or anything ending with a '/'
+			addState(Split, 0, following, following + 2);
+			addState(Any, 0, following, following + 1);
+			addState(Byte, '/', following + 2, None);
+			break;
+		}
+	}
+	addState(Accept, id, None, None);
+
+	std::vector<unsigned int> reached;
+	for (unsigned int state = first; state < states.size(); ++state)
+	{
+		reached.clear();
+		closeOver(state, reached);
+		closures.insert(closures.end(), reached.begin(), reached.end());
+		closureBegin.push_back((unsigned int)closures.size());
+	}
+	starts.insert(starts.end(), closures.begin() + closureBegin[first], closures.begin() + closureBegin[first + 1]);
+	return id;
+}
+
+auto	MGlobSet::FirstMatch(MStringView path) const -> unsigned int
+{
+	unsigned int found = NoMatch;
+	Match(path, [&found](unsigned int id)
+	{
+		found = id;
+		return false;
+	});
+	return found;
+}
+
+auto	MGlobSet::addState(StateKind kind, unsigned int value, unsigned int next, unsigned int skip) -> unsigned int
+{
+	states.push_back(State{ kind, (unsigned char)value, value, next, skip });
+	return (unsigned int)states.size() - 1;
+}
+
+auto	MGlobSet::closeOver(unsigned int state, std::vector<unsigned int>& reached) const -> void
+{
+	State const& current = states[state];
+	if (current.kind != Split)
+	{
+		if (std::find(reached.begin(), reached.end(), state) != reached.end())
+			return;
+		reached.push_back(state);
+	}
+	else
+		closeOver(current.next, reached);
+	if (current.skip != None)
+		closeOver(current.skip, reached);
+}
+
+auto	MGlobSet::run(MStringView path, unsigned int* scratch) const -> unsigned int
+{
+	unsigned int*	live = scratch;
+	unsigned int*	following = scratch + states.size();
+	//Step + 1 at which a state was last added, so a state is only listed once per step
+	unsigned int*	added = following + states.size();
+	unsigned int	liveCount = (unsigned int)starts.size();
+	memset(added, 0, states.size() * sizeof(unsigned int));
+	std::copy(starts.begin(), starts.end(), live);
+
+	char const*		data = path.Data();
+	for (unsigned int pos = 0; pos < path.Count() && liveCount; ++pos)
+	{
+		unsigned char	c = (unsigned char)data[pos];
+		unsigned int	followingCount = 0;
+		for (unsigned int idx = 0; idx < liveCount; ++idx)
+		{
+			State const& state = states[live[idx]];
+			if (!reads(state, c))
+				continue;
+			for (unsigned int reached = closureBegin[state.next]; reached < closureBegin[state.next + 1]; ++reached)
+			{
+				unsigned int target = closures[reached];
+				if (added[target] != pos + 1)
+				{
+					added[target] = pos + 1;
+					following[followingCount++] = target;
+				}
+			}
+		}
+		std::swap(live, following);
+		liveCount = followingCount;
+	}
+
+	unsigned int found = 0;
+	for (unsigned int idx = 0; idx < liveCount; ++idx)
+	{
+		if (states[live[idx]].kind == Accept)
+			scratch[found++] = states[live[idx]].value;
+	}
+	std::sort(scratch, scratch + found);
+	return found;
+}
+
+//Subset construction over byte classes: a DFA state is a sorted set of live NFA states
+auto	MGlobSet::Build() -> bool
+{
+	transitions.clear();
+	acceptBegin.clear();
+	acceptIds.clear();
+
+	//Splits the classes along every set of bytes a state reads, classes stay numbered in order of their first byte
+	classCount = 1;
+	memset(byteClasses, 0, sizeof(byteClasses));
+	bool	byteSplit[256] = {};
+	for (State const& state : states)
+	{
+		if (state.kind == Any || state.kind == Split || state.kind == Accept || (state.kind == Byte && byteSplit[state.byte]))
+			continue;
+		if (state.kind == Byte)
+			byteSplit[state.byte] = true;
+		unsigned int renamed[512];
+		memset(renamed, 0xFF, sizeof(renamed));
+		classCount = 0;
+		for (unsigned int c = 0; c < 256; ++c)
+		{
+			unsigned int key = byteClasses[c] * 2 + (reads(state, (unsigned char)c) ? 1 : 0);
+			if (renamed[key] == None)
+				renamed[key] = classCount++;
+			byteClasses[c] = (unsigned char)renamed[key];
+		}
+	}
+	unsigned char representative[256];
+	for (unsigned int c = 256; c-- > 0;)
+		representative[byteClasses[c]] = (unsigned char)c;
+
+	std::map<std::vector<unsigned int>, unsigned int>	ids;
+	std::vector<std::vector<unsigned int>>				sets;
+	auto												idOf = [&ids, &sets](std::vector<unsigned int>& set)
+	{
+		std::sort(set.begin(), set.end());
+		auto inserted = ids.emplace(set, (unsigned int)sets.size());
+		if (inserted.second)
+			sets.push_back(set);
+		return inserted.first->second;
+	};
+	std::vector<unsigned int>	set;
+	std::vector<char>			added(states.size(), 0);
+	idOf(set);
+	set = starts;
+	startState = idOf(set);
+	for (unsigned int done = 0; done < sets.size(); ++done)
+	{
+		std::vector<unsigned int> current = sets[done];
+		for (unsigned int cls = 0; cls < classCount; ++cls)
+		{
+			set.clear();
+			for (unsigned int live : current)
+			{
+				State const& state = states[live];
+				if (!reads(state, representative[cls]))
+					continue;
+				for (unsigned int reached = closureBegin[state.next]; reached < closureBegin[state.next + 1]; ++reached)
+				{
+					unsigned int target = closures[reached];
+					if (!added[target])
+					{
+						added[target] = 1;
+						set.push_back(target);
+					}
+				}
+			}
+			for (unsigned int target : set)
+				added[target] = 0;
+			transitions.push_back(idOf(set));
+			if (sets.size() > MaxDfaStates)
+			{
+				transitions.clear();
+				acceptBegin.clear();
+				acceptIds.clear();
+				return false;
+			}
+		}
+		acceptBegin.push_back((unsigned int)acceptIds.size());
+		for (unsigned int live : current)
+		{
+			if (states[live].kind == Accept)
+				acceptIds.push_back(states[live].value);
+		}
+		std::sort(acceptIds.begin() + acceptBegin.back(), acceptIds.end());
+	}
+	acceptBegin.push_back((unsigned int)acceptIds.size());
+	return true;
+}
+
+auto	MGlobSet::walk(MStringView path) const -> unsigned int
+{
+	unsigned int	state = startState;
+	char const*		data = path.Data();
+	for (unsigned int pos = 0; pos < path.Count() && state != 0; ++pos)
+		state = transitions[state * classCount + byteClasses[(unsigned char)data[pos]]];
+	return state;
+}
+
+auto	MGlobSet::FindAll(MStringView path, std::vector<unsigned int>& ids) const -> unsigned int
+{
+	size_t before = ids.size();
+	Match(path, [&ids](unsigned int id)
+	{
+		ids.push_back(id);
+		return true;
+	});
+	return (unsigned int)(ids.size() - before);
+}
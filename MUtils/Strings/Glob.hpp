@@ -0,0 +1,210 @@
+#ifndef __MGLOB_HPP__
+#define __MGLOB_HPP__
+
+#include <vector>
+
+#include "../String.hpp"
+
+//Glob pattern compiled once into literal runs and wildcards, matched against a whole path without allocating.
+//	?		any char but '/'
+//	*		any run of chars without '/'
+//	**/		zero or more whole directories when it starts a segment, as in textures/**/diffuse.png
+//	**		anything, '/' included, anywhere else
+//	[a-z]	a char of the class, [!a-z] or [^a-z] for the others, never '/'
+//The pattern has to match the whole path, write **/*.mesh to match files at any depth.
+//The leading and trailing literal runs are compared at once before the wildcards are walked.
+class MGlob
+{
+public:
+	MGlob() = default;
+	explicit MGlob(MStringView pattern) { Compile(pattern); }
+
+	auto	Compile(MStringView pattern) -> void;
+
+	auto	Pattern() const -> MStringView { return pattern; }
+
+	auto	Match(MStringView path) const -> bool
+	{
+		char const*		data = path.Data();
+		unsigned int	count = path.Count();
+		if (count < minLength)
+			return false;
+		if (prefixLength && memcmp(data, pattern.Str(), prefixLength) != 0)
+			return false;
+		if (suffixLength && memcmp(data + count - suffixLength, pattern.Str() + suffixOffset, suffixLength) != 0)
+			return false;
+		return matchTokens(data + prefixLength, count - prefixLength - suffixLength);
+	}
+
+	//Last char of every path the pattern matches, -1 when it ends with a wildcard
+	auto	LastChar() const -> int { return lastChar; }
+
+private:
+	//Compiles the tokens into its automaton
+	friend class MGlobSet;
+
+	enum TokenKind : unsigned char
+	{
+		Literal,
+		AnyChar,
+		Class,
+		Star,
+		GlobAny,
+		GlobSegments,
+	};
+
+	//Literals are offset and length in the pattern, classes are an index in classes
+	struct Token
+	{
+		TokenKind		kind;
+		unsigned int	offset;
+		unsigned int	length;
+	};
+
+	struct CharClass
+	{
+		unsigned int	bits[8];
+	};
+
+	auto	matchTokens(char const* text, unsigned int count) const -> bool;
+	auto	parseClass(unsigned int pos) -> unsigned int;
+
+	MString					pattern;
+	std::vector<Token>		tokens;
+	std::vector<CharClass>	classes;
+	//Tokens walked between the prefix and the suffix
+	unsigned int			tokenBegin = 0;
+	unsigned int			tokenEnd = 0;
+	unsigned int			prefixLength = 0;
+	unsigned int			suffixOffset = 0;
+	unsigned int			suffixLength = 0;
+	unsigned int			minLength = 0;
+	int						lastChar = -1;
+};
+
+//Rule set compiled into one automaton matched in a single pass over the path, whatever the number of rules.
+//Add builds a Thompson NFA: the states of every rule still able to match advance together on each char, without
+//backtracking, so a char costs the number of live states. Build turns it into a DFA reading one transition per char.
+//Without Build, or when the DFA would be too large, Match runs the NFA. It allocates nothing under StackStates states.
+class MGlobSet
+{
+public:
+	static const unsigned int	NoMatch = 0xFFFFFFFF;
+	//Above this many states the NFA works in a heap buffer
+	static const unsigned int	StackStates = 512;
+	static const unsigned int	MaxDfaStates = 4096;
+
+	//Returns the rule id, ids are given in order from 0. Adding a rule drops the DFA until the next Build.
+	auto	Add(MStringView pattern) -> unsigned int;
+	//Returns false when the DFA would need more than MaxDfaStates states, Match keeps running the NFA then.
+	//Like Match, Build must not run while other threads match.
+	auto	Build() -> bool;
+	auto	IsBuilt() const -> bool { return !transitions.empty(); }
+
+	auto	RuleCount() const -> unsigned int { return (unsigned int)globs.size(); }
+	auto	StateCount() const -> unsigned int { return (unsigned int)states.size(); }
+	auto	Rule(unsigned int id) const -> MGlob const& { return globs[id]; }
+
+	//Calls callback(id) for every matching rule in id order, stops early when callback returns false
+	template<class Callback>
+	auto	Match(MStringView path, Callback&& callback) const -> void;
+
+	auto	FirstMatch(MStringView path) const -> unsigned int;
+	auto	MatchesAny(MStringView path) const -> bool { return FirstMatch(path) != NoMatch; }
+	//Appends the ids of the matching rules to ids, returns how many were found
+	auto	FindAll(MStringView path, std::vector<unsigned int>& ids) const -> unsigned int;
+
+private:
+	//Byte, Class, NotSlash and Any read one char and go to next, Accept reports the rule in value.
+	//Split reads nothing and goes to both next and skip, the wildcards also skip to the following token.
+	enum StateKind : unsigned char
+	{
+		Byte,
+		Class,
+		NotSlash,
+		Any,
+		Split,
+		Accept,
+	};
+
+	struct State
+	{
+		StateKind		kind;
+		unsigned char	byte;
+		unsigned int	value;
+		unsigned int	next;
+		unsigned int	skip;
+	};
+
+	static const unsigned int	None = 0xFFFFFFFF;
+
+	auto	addState(StateKind kind, unsigned int value, unsigned int next, unsigned int skip) -> unsigned int;
+	auto	reads(State const& state, unsigned char c) const -> bool
+	{
+		switch (state.kind)
+		{
+		case Byte: return c == state.byte;
+		case Class: return (classes[state.value].bits[c >> 5] >> (c & 31) & 1) != 0;
+		case NotSlash: return c != '/';
+		case Any: return true;
+		default: return false;
+		}
+	}
+
+	//Appends the reading and accepting states reached from state without reading, once each
+	auto	closeOver(unsigned int state, std::vector<unsigned int>& reached) const -> void;
+	//Runs the automaton over path in scratch (3 entries per state), returns how many rules matched.
+	//Their ids are left sorted at the start of scratch.
+	auto	run(MStringView path, unsigned int* scratch) const -> unsigned int;
+	//Last DFA state reached by path, 0 once no rule can match
+	auto	walk(MStringView path) const -> unsigned int;
+
+	std::vector<MGlob>				globs;
+	std::vector<State>				states;
+	std::vector<MGlob::CharClass>	classes;
+	//States reached from state n without reading, closures[closureBegin[n]] up to closures[closureBegin[n + 1]]
+	std::vector<unsigned int>		closureBegin = std::vector<unsigned int>(1, 0);
+	std::vector<unsigned int>		closures;
+	//Live states before the first char, the closures of the first state of every rule
+	std::vector<unsigned int>		starts;
+
+	//Bytes no state tells apart share a class. transitions are indexed by state * classCount + class,
+	//state 0 matches nothing and DFA state n accepts acceptIds[acceptBegin[n]] up to acceptIds[acceptBegin[n + 1]].
+	unsigned char					byteClasses[256] = {};
+	unsigned int					classCount = 0;
+	unsigned int					startState = 0;
+	std::vector<unsigned int>		transitions;
+	std::vector<unsigned int>		acceptBegin;
+	std::vector<unsigned int>		acceptIds;
+};
+
+template<class Callback>
+auto	MGlobSet::Match(MStringView path, Callback&& callback) const -> void
+{
+	if (IsBuilt())
+	{
+		unsigned int state = walk(path);
+		for (unsigned int idx = acceptBegin[state]; idx < acceptBegin[state + 1]; ++idx)
+		{
+			if (!callback(acceptIds[idx]))
+				return;
+		}
+		return;
+	}
+	unsigned int				stackScratch[3 * StackStates];
+	std::vector<unsigned int>	heapScratch;
+	unsigned int*				scratch = stackScratch;
+	if (states.size() > StackStates)
+	{
+		heapScratch.resize(3 * states.size());
+		scratch = heapScratch.data();
+	}
+	unsigned int found = run(path, scratch);
+	for (unsigned int idx = 0; idx < found; ++idx)
+	{
+		if (!callback(scratch[idx]))
+			return;
+	}
+}
+
+#endif /*__MGLOB_HPP__*/
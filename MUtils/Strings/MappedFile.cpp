@@ -0,0 +1,121 @@
+#include "MappedFile.hpp"
+
+#include <cstdio>
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+auto	MMappedFile::Open(char const* path) -> bool
+{
+	Close();
+#ifdef _WIN32
+	MWString	widePath = MWString::FromUTF8(path);
+	HANDLE		handle = CreateFileW(widePath.Str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (handle == INVALID_HANDLE_VALUE)
+		return false;
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(handle, &fileSize) || (unsigned long long)fileSize.QuadPart > (size_t)-1)
+	{
+		CloseHandle(handle);
+		return false;
+	}
+	file = handle;
+	opened = true;
+	//Empty files cannot be mapped
+	if (fileSize.QuadPart == 0)
+		return true;
+	mapping = CreateFileMappingW(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+	if (!view)
+	{
+		Close();
+		return false;
+	}
+	data = (char const*)view;
+	size = (unsigned long long)fileSize.QuadPart;
+#else
+	int handle = open(path, O_RDONLY);
+	if (handle < 0)
+		return false;
+	struct stat info;
+	if (fstat(handle, &info) != 0 || (unsigned long long)info.st_size > (size_t)-1)
+	{
+		close(handle);
+		return false;
+	}
+	void* view = info.st_size ? mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, handle, 0) : nullptr;
+	//The mapping keeps its own reference to the file
+	close(handle);
+	if (view == MAP_FAILED)
+		return false;
+	if (view)
+	{
+		madvise(view, (size_t)info.st_size, MADV_SEQUENTIAL);
+		data = (char const*)view;
+		size = (unsigned long long)info.st_size;
+	}
+	opened = true;
+#endif
+	return true;
+}
+
+auto	MMappedFile::Close() -> void
+{
+	if (!opened)
+		return;
+#ifdef _WIN32
+	if (size)
+		UnmapViewOfFile(data);
+	if (mapping)
+		CloseHandle(mapping);
+	CloseHandle(file);
+	mapping = nullptr;
+	file = nullptr;
+#else
+	if (size)
+		munmap((void*)data, (size_t)size);
+#endif
+	data = "";
+	size = 0;
+	opened = false;
+}
+
+auto	MMappedFile::ReadAll(char const* path, MString& content) -> bool
+{
+#ifdef _WIN32
+	FILE* file = _wfopen(MWString::FromUTF8(path).Str(), L"rb");
+#else
+	FILE* file = fopen(path, "rb");
+#endif
+	if (!file)
+		return false;
+#ifdef _WIN32
+	struct _stat64	info;
+	bool			known = _fstat64(_fileno(file), &info) == 0;
+#else
+	struct stat		info;
+	bool			known = fstat(fileno(file), &info) == 0;
+#endif
+	if (!known || (unsigned long long)info.st_size >= MStringView::Npos)
+	{
+		fclose(file);
+		return false;
+	}
+
+	unsigned int	size = (unsigned int)info.st_size;
+	content.Empty();
+	unsigned int	read = (unsigned int)fread(content.ResizeForOverwrite(size), 1, size, file);
+	content.ResizeForOverwrite(read);
+	bool			complete = read == size && !ferror(file);
+	fclose(file);
+	return complete;
+}
@@ -0,0 +1,130 @@
+#ifndef __MMAPPEDFILE_HPP__
+#define __MMAPPEDFILE_HPP__
+
+#include "../String.hpp"
+
+//Lines of a buffer as views, without copy. Sizes are 64 bit so a whole multi GB file can be walked,
+//a single line is limited to what a MStringView can hold. '\n' ends a line and a '\r' before it is
+//dropped, the last line does not need a newline.
+class MStringLines
+{
+public:
+	class Iterator
+	{
+	public:
+		auto	operator*() const -> MStringView const& { return line; }
+		auto	operator->() const -> MStringView const* { return &line; }
+		auto	operator++() -> Iterator& { next(); return *this; }
+		auto	operator==(Iterator const& other) const -> bool { return start == other.start; }
+		auto	operator!=(Iterator const& other) const -> bool { return start != other.start; }
+
+	private:
+		friend class MStringLines;
+
+		Iterator(char const* data, unsigned long long size, unsigned long long pos) : data(data), size(size), start(pos), following(pos)
+		{
+			next();
+		}
+
+		auto	next() -> void
+		{
+			start = following;
+			if (start >= size)
+			{
+				start = size;
+				return;
+			}
+			unsigned long long end = FindNewline(data, size, start);
+			following = end < size ? end + 1 : size;
+			if (end > start && data[end - 1] == '\r')
+				--end;
+			line = MStringView(data + start, (unsigned int)(end - start));
+		}
+
+		char const*			data;
+		unsigned long long	size;
+		unsigned long long	start;
+		unsigned long long	following;
+		MStringView			line;
+	};
+
+	MStringLines(char const* data, unsigned long long size) : data(data), size(size) {}
+	explicit MStringLines(MStringView text) : data(text.Data()), size(text.Count()) {}
+
+	auto	begin() const -> Iterator { return Iterator(data, size, 0); }
+	auto	end() const -> Iterator { return Iterator(data, size, size); }
+
+	//Position of the first '\n' at or after from, size when there is none
+	static auto	FindNewline(char const* data, unsigned long long size, unsigned long long from) -> unsigned long long
+	{
+		unsigned long long pos = from;
+#ifdef MSTRING_AVX2
+		__m256i wide = _mm256_set1_epi8('\n');
+		for (; pos + 32 <= size; pos += 32)
+		{
+			unsigned int mask = (unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_loadu_si256((__m256i const*)(data + pos)), wide));
+			if (mask != 0)
+				return pos + MStringSearch::LowestBit(mask);
+		}
+#endif
+#ifdef MSTRING_SSE2
+		__m128i newline = _mm_set1_epi8('\n');
+		for (; pos + 16 <= size; pos += 16)
+		{
+			unsigned int mask = (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128((__m128i const*)(data + pos)), newline));
+			if (mask != 0)
+				return pos + MStringSearch::LowestBit(mask);
+		}
+#endif
+		for (; pos < size; ++pos)
+		{
+			if (data[pos] == '\n')
+				return pos;
+		}
+		return size;
+	}
+
+private:
+	char const*			data;
+	unsigned long long	size;
+};
+
+//Read only view of a whole file mapped in memory, nothing is copied. Paths are UTF-8.
+//An empty file opens fine and has no data. On 32 bit builds the file must fit in the address space.
+class MMappedFile
+{
+public:
+	MMappedFile() = default;
+	explicit MMappedFile(char const* path) { Open(path); }
+	MMappedFile(MMappedFile const&) = delete;
+	auto	operator=(MMappedFile const&) -> MMappedFile& = delete;
+
+	~MMappedFile() { Close(); }
+
+	//Closes the current file first, returns false when the file could not be mapped
+	auto	Open(char const* path) -> bool;
+	auto	Close() -> void;
+
+	auto	IsOpen() const -> bool { return opened; }
+	auto	Data() const -> char const* { return data; }
+	auto	Size() const -> unsigned long long { return size; }
+
+	//Whole content, a view cannot address more than 4 GB so larger files are cut, walk Lines instead
+	auto	View() const -> MStringView { return MStringView(data, size < MStringView::Npos ? (unsigned int)size : MStringView::Npos - 1); }
+	auto	Lines() const -> MStringLines { return MStringLines(data, size); }
+
+	//Fallback without mapping: reads the file into content with one allocation sized from the file size.
+	//Returns false when the file cannot be read or does not fit in a MString.
+	static auto	ReadAll(char const* path, MString& content) -> bool;
+
+private:
+	char const*			data = "";
+	unsigned long long	size = 0;
+	bool				opened = false;
+#ifdef _WIN32
+	void*				file = nullptr;
+	void*				mapping = nullptr;
+#endif
+};
+
+#endif /*__MMAPPEDFILE_HPP__*/
@@ -0,0 +1,595 @@
+#ifndef __MRADIXTRIE_HPP__
+#define __MRADIXTRIE_HPP__
+
+#include <new>
+#include <utility>
+
+#include "../String.hpp"
+
+//Radix tree with path compression and adaptive node sizes (ART): a node stores the bytes its keys share after the
+//parent edge, then its children in a node sized for their number (none, 4, 16, 48 or 256). Memory follows the
+//number of distinct prefixes, and a lookup reads about one node per branching byte of the key.
+//Keys are any bytes, a key may be a prefix of another one. Enumeration is in byte order.
+template<class T>
+class MRadixTrie
+{
+public:
+	MRadixTrie() : root(newNode(Leaf, 0)) {}
+	MRadixTrie(MRadixTrie const&) = delete;
+	auto	operator=(MRadixTrie const&) -> MRadixTrie& = delete;
+
+	~MRadixTrie() { freeTree(root); }
+
+	auto	Count() const -> unsigned int { return count; }
+	auto	NodeCount() const -> unsigned int { return nodes; }
+	auto	MemoryUsage() const -> unsigned long long { return memory; }
+
+	auto	Clear() -> void
+	{
+		freeTree(root);
+		count = 0;
+		nodes = 0;
+		memory = 0;
+		root = newNode(Leaf, 0);
+	}
+
+	//Adds key or replaces its value, returns true when key was not present
+	auto	Insert(MStringView key, T value) -> bool;
+	//Returns false when key is not present
+	auto	Remove(MStringView key) -> bool;
+
+	auto	Find(MStringView key) -> T* { return const_cast<T*>(static_cast<MRadixTrie const*>(this)->Find(key)); }
+	auto	Find(MStringView key) const -> T const*;
+	auto	Contains(MStringView key) const -> bool { return Find(key) != nullptr; }
+
+	//Value of the longest key that starts text, nullptr when none does. length receives the length of that key.
+	auto	LongestPrefix(MStringView text, unsigned int* length = nullptr) const -> T const*;
+
+	//Calls callback(MStringView key, T const& value) for every key starting with prefix in byte order,
+	//stops early when callback returns false. The key view is only valid during the call.
+	template<class Callback>
+	auto	ForEachPrefixed(MStringView prefix, Callback&& callback) const -> void;
+
+	template<class Callback>
+	auto	ForEach(Callback&& callback) const -> void { ForEachPrefixed(MStringView(), callback); }
+
+private:
+	enum NodeKind : unsigned char
+	{
+		Leaf,
+		Node4,
+		Node16,
+		Node48,
+		Node256,
+	};
+
+	//The compressed prefix is stored right after the node, see prefix
+	struct Node
+	{
+		NodeKind		kind;
+		bool			hasValue;
+		unsigned short	children;
+		unsigned int	prefixLength;
+		T				value;
+	};
+
+	//Keys are kept sorted so enumeration is in order
+	template<unsigned int Capacity>
+	struct SmallNode : Node
+	{
+		unsigned char	keys[Capacity];
+		Node*			children[Capacity];
+	};
+
+	//index holds the slot + 1 of each present byte
+	struct IndexedNode : Node
+	{
+		unsigned char	index[256];
+		Node*			children[48];
+	};
+
+	struct FullNode : Node
+	{
+		Node*			children[256];
+	};
+
+	static auto	nodeSize(NodeKind kind) -> unsigned int
+	{
+		return kind == Leaf ? sizeof(Node) : kind == Node4 ? sizeof(SmallNode<4>) : kind == Node16 ? sizeof(SmallNode<16>)
+			: kind == Node48 ? sizeof(IndexedNode) : sizeof(FullNode);
+	}
+
+	static auto	capacity(NodeKind kind) -> unsigned int { return kind == Leaf ? 0 : kind == Node4 ? 4 : kind == Node16 ? 16 : kind == Node48 ? 48 : 256; }
+
+	static auto	prefix(Node* node) -> char* { return (char*)node + nodeSize(node->kind); }
+	static auto	prefix(Node const* node) -> char const* { return (char const*)node + nodeSize(node->kind); }
+
+	auto	newNode(NodeKind kind, unsigned int prefixLength) -> Node*
+	{
+		void*	memoryBlock = ::operator new(nodeSize(kind) + prefixLength);
+		Node*	node;
+		switch (kind)
+		{
+		case Leaf: node = new (memoryBlock) Node(); break;
+		case Node4: node = new (memoryBlock) SmallNode<4>(); break;
+		case Node16: node = new (memoryBlock) SmallNode<16>(); break;
+		case Node48: node = new (memoryBlock) IndexedNode(); break;
+		default: node = new (memoryBlock) FullNode(); break;
+		}
+		node->kind = kind;
+		node->prefixLength = prefixLength;
+		++nodes;
+		memory += nodeSize(kind) + prefixLength;
+		return node;
+	}
+
+	auto	freeNode(Node* node) -> void
+	{
+		--nodes;
+		memory -= nodeSize(node->kind) + node->prefixLength;
+		node->~Node();
+		::operator delete(node);
+	}
+
+	auto	freeTree(Node* node) -> void
+	{
+		forEachChild(node, [this](unsigned char, Node* child)
+		{
+			freeTree(child);
+			return true;
+		});
+		freeNode(node);
+	}
+
+	//Leaf holding the end of a key and its value
+	auto	newLeaf(char const* rest, unsigned int length, T&& value) -> Node*
+	{
+		Node* leaf = newNode(Leaf, length);
+		memcpy(prefix(leaf), rest, length);
+		leaf->hasValue = true;
+		leaf->value = std::move(value);
+		return leaf;
+	}
+
+	//Same node with another kind and prefix, children and value moved over. The old node is freed.
+	auto	rebuild(Node* node, NodeKind kind, char const* newPrefix, unsigned int prefixLength) -> Node*
+	{
+		Node* built = newNode(kind, prefixLength);
+		memcpy(prefix(built), newPrefix, prefixLength);
+		built->hasValue = node->hasValue;
+		built->value = std::move(node->value);
+		forEachChild(node, [this, built](unsigned char key, Node* child)
+		{
+			insertChild(built, key, child);
+			return true;
+		});
+		freeNode(node);
+		return built;
+	}
+
+	static auto	findChild(Node const* node, unsigned char key) -> Node* const*
+	{
+		switch (node->kind)
+		{
+		case Node4:
+		{
+			SmallNode<4> const* small = static_cast<SmallNode<4> const*>(node);
+			for (unsigned int idx = 0; idx < node->children; ++idx)
+			{
+				if (small->keys[idx] == key)
+					return &small->children[idx];
+			}
+			return nullptr;
+		}
+		case Node16:
+		{
+			SmallNode<16> const* small = static_cast<SmallNode<16> const*>(node);
+#ifdef MSTRING_SSE2
+			unsigned int mask = (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8((char)key), _mm_loadu_si128((__m128i const*)small->keys)));
+			mask &= (1u << node->children) - 1;
+			return mask ? &small->children[MStringSearch::LowestBit(mask)] : nullptr;
+#else
+			for (unsigned int idx = 0; idx < node->children; ++idx)
+			{
+				if (small->keys[idx] == key)
+					return &small->children[idx];
+			}
+			return nullptr;
+#endif
+		}
+		case Node48:
+		{
+			IndexedNode const* indexed = static_cast<IndexedNode const*>(node);
+			return indexed->index[key] ? &indexed->children[indexed->index[key] - 1] : nullptr;
+		}
+		case Node256:
+		{
+			FullNode const* full = static_cast<FullNode const*>(node);
+			return full->children[key] ? &full->children[key] : nullptr;
+		}
+		default:
+			return nullptr;
+		}
+	}
+
+	static auto	findChild(Node* node, unsigned char key) -> Node**
+	{
+		return const_cast<Node**>(findChild(static_cast<Node const*>(node), key));
+	}
+
+	//node has room for the child
+	static auto	insertChild(Node* node, unsigned char key, Node* child) -> void
+	{
+		switch (node->kind)
+		{
+		case Node4:
+			insertSorted(static_cast<SmallNode<4>*>(node)->keys, static_cast<SmallNode<4>*>(node)->children, node->children, key, child);
+			break;
+		case Node16:
+			insertSorted(static_cast<SmallNode<16>*>(node)->keys, static_cast<SmallNode<16>*>(node)->children, node->children, key, child);
+			break;
+		case Node48:
+		{
+			IndexedNode* indexed = static_cast<IndexedNode*>(node);
+			indexed->children[node->children] = child;
+			indexed->index[key] = (unsigned char)(node->children + 1);
+			break;
+		}
+		default:
+			static_cast<FullNode*>(node)->children[key] = child;
+			break;
+		}
+		++node->children;
+	}
+
+	static auto	insertSorted(unsigned char* keys, Node** children, unsigned int used, unsigned char key, Node* child) -> void
+	{
+		unsigned int pos = used;
+		for (; pos > 0 && keys[pos - 1] > key; --pos)
+		{
+			keys[pos] = keys[pos - 1];
+			children[pos] = children[pos - 1];
+		}
+		keys[pos] = key;
+		children[pos] = child;
+	}
+
+	static auto	removeChild(Node* node, unsigned char key) -> void
+	{
+		switch (node->kind)
+		{
+		case Node4:
+			removeSorted(static_cast<SmallNode<4>*>(node)->keys, static_cast<SmallNode<4>*>(node)->children, node->children, key);
+			break;
+		case Node16:
+			removeSorted(static_cast<SmallNode<16>*>(node)->keys, static_cast<SmallNode<16>*>(node)->children, node->children, key);
+			break;
+		case Node48:
+		{
+			//The last slot moves into the freed one
+			IndexedNode*	indexed = static_cast<IndexedNode*>(node);
+			unsigned int	slot = indexed->index[key] - 1;
+			unsigned int	last = node->children - 1u;
+			indexed->index[key] = 0;
+			if (slot != last)
+			{
+				for (unsigned int byte = 0; byte < 256; ++byte)
+				{
+					if (indexed->index[byte] == last + 1)
+					{
+						indexed->index[byte] = (unsigned char)(slot + 1);
+						break;
+					}
+				}
+				indexed->children[slot] = indexed->children[last];
+			}
+			break;
+		}
+		default:
+			static_cast<FullNode*>(node)->children[key] = nullptr;
+			break;
+		}
+		--node->children;
+	}
+
+	static auto	removeSorted(unsigned char* keys, Node** children, unsigned int used, unsigned char key) -> void
+	{
+		unsigned int pos = 0;
+		while (keys[pos] != key)
+			++pos;
+		for (; pos + 1 < used; ++pos)
+		{
+			keys[pos] = keys[pos + 1];
+			children[pos] = children[pos + 1];
+		}
+	}
+
+	//Calls visit(key, child) in key order until it returns false, returns false when it was stopped
+	template<class Visit>
+	static auto	forEachChild(Node const* node, Visit const& visit) -> bool
+	{
+		switch (node->kind)
+		{
+		case Node4:
+		case Node16:
+		{
+			unsigned char const*	keys = node->kind == Node4 ? static_cast<SmallNode<4> const*>(node)->keys : static_cast<SmallNode<16> const*>(node)->keys;
+			Node* const*			children = node->kind == Node4 ? static_cast<SmallNode<4> const*>(node)->children : static_cast<SmallNode<16> const*>(node)->children;
+			for (unsigned int idx = 0; idx < node->children; ++idx)
+			{
+				if (!visit(keys[idx], children[idx]))
+					return false;
+			}
+			return true;
+		}
+		case Node48:
+		{
+			IndexedNode const* indexed = static_cast<IndexedNode const*>(node);
+			for (unsigned int byte = 0; byte < 256; ++byte)
+			{
+				if (indexed->index[byte] && !visit((unsigned char)byte, indexed->children[indexed->index[byte] - 1]))
+					return false;
+			}
+			return true;
+		}
+		case Node256:
+		{
+			FullNode const* full = static_cast<FullNode const*>(node);
+			for (unsigned int byte = 0; byte < 256; ++byte)
+			{
+				if (full->children[byte] && !visit((unsigned char)byte, full->children[byte]))
+					return false;
+			}
+			return true;
+		}
+		default:
+			return true;
+		}
+	}
+
+	//Number of bytes of the node prefix matching key from pos
+	static auto	matchPrefix(Node const* node, MStringView key, unsigned int pos) -> unsigned int
+	{
+		char const*		bytes = prefix(node);
+		unsigned int	length = node->prefixLength < key.Count() - pos ? node->prefixLength : key.Count() - pos;
+		unsigned int	common = 0;
+		while (common < length && bytes[common] == key.Data()[pos + common])
+			++common;
+		return common;
+	}
+
+	//Node moves down a size class once its children fit the smaller one with room to spare, so removing and adding
+	//around a capacity does not rebuild it every time. A Node4 without children becomes a leaf.
+	auto	shrink(Node** slot) -> void
+	{
+		Node*			node = *slot;
+		unsigned int	children = node->children;
+		bool			fits = node->kind == Node256 ? children <= 37 : node->kind == Node48 ? children <= 12
+			: node->kind == Node16 ? children <= 3 : node->kind == Node4 && children == 0;
+		if (fits)
+			*slot = rebuild(node, node->kind == Node4 ? Leaf : (NodeKind)(node->kind - 1), prefix(node), node->prefixLength);
+	}
+
+	//Node without value and with a single child is merged with that child
+	auto	collapse(Node** slot) -> void
+	{
+		Node* node = *slot;
+		if (node == root || node->hasValue || node->children != 1)
+			return;
+		unsigned char	key = 0;
+		Node*			child = nullptr;
+		forEachChild(node, [&key, &child](unsigned char childKey, Node* childNode)
+		{
+			key = childKey;
+			child = childNode;
+			return false;
+		});
+		MString merged(MStringView(prefix(node), node->prefixLength));
+		merged += (char)key;
+		merged += MStringView(prefix(child), child->prefixLength);
+		freeNode(node);
+		*slot = rebuild(child, child->kind, merged.Str(), merged.Count());
+	}
+
+	template<class Callback>
+	auto	visitTree(Node const* node, MString& key, Callback& callback) const -> bool
+	{
+		unsigned int length = key.Count();
+		key += MStringView(prefix(node), node->prefixLength);
+		if (node->hasValue && !callback(MStringView(key), static_cast<T const&>(node->value)))
+			return false;
+		bool complete = forEachChild(node, [this, &key, &callback](unsigned char byte, Node const* child)
+		{
+			unsigned int before = key.Count();
+			key += (char)byte;
+			bool goOn = visitTree(child, key, callback);
+			key.RemoveAt(before, key.Count() - before);
+			return goOn;
+		});
+		key.RemoveAt(length, key.Count() - length);
+		return complete;
+	}
+
+	unsigned int		count = 0;
+	unsigned int		nodes = 0;
+	unsigned long long	memory = 0;
+	Node*				root;
+};
+
+template<class T>
+auto	MRadixTrie<T>::Insert(MStringView key, T value) -> bool
+{
+	Node**			slot = &root;
+	unsigned int	pos = 0;
+	for (;;)
+	{
+		Node*			node = *slot;
+		unsigned int	common = matchPrefix(node, key, pos);
+		if (common < node->prefixLength)
+		{
+			//The key leaves the compressed prefix: a new node takes the shared part, the old one keeps the rest
+			Node*			parent = newNode(Node4, common);
+			unsigned char	edge = (unsigned char)prefix(node)[common];
+			memcpy(prefix(parent), prefix(node), common);
+			*slot = parent;
+			insertChild(parent, edge, rebuild(node, node->kind, prefix(node) + common + 1, node->prefixLength - common - 1));
+			pos += common;
+			if (pos == key.Count())
+			{
+				parent->hasValue = true;
+				parent->value = std::move(value);
+			}
+			else
+				insertChild(parent, (unsigned char)key.Data()[pos], newLeaf(key.Data() + pos + 1, key.Count() - pos - 1, std::move(value)));
+			++count;
+			return true;
+		}
+		pos += common;
+		if (pos == key.Count())
+		{
+			bool added = !node->hasValue;
+			node->hasValue = true;
+			node->value = std::move(value);
+			count += added;
+			return added;
+		}
+		unsigned char	byte = (unsigned char)key.Data()[pos];
+		Node**			child = findChild(node, byte);
+		if (child)
+		{
+			slot = child;
+			++pos;
+			continue;
+		}
+		if (node->children == capacity(node->kind))
+		{
+			node = rebuild(node, (NodeKind)(node->kind + 1), prefix(node), node->prefixLength);
+			*slot = node;
+		}
+		insertChild(node, byte, newLeaf(key.Data() + pos + 1, key.Count() - pos - 1, std::move(value)));
+		++count;
+		return true;
+	}
+}
+
+template<class T>
+auto	MRadixTrie<T>::Remove(MStringView key) -> bool
+{
+	Node**			parentSlot = nullptr;
+	Node**			slot = &root;
+	unsigned char	edge = 0;
+	unsigned int	pos = 0;
+	for (;;)
+	{
+		Node* node = *slot;
+		if (matchPrefix(node, key, pos) != node->prefixLength)
+			return false;
+		pos += node->prefixLength;
+		if (pos == key.Count())
+			break;
+		Node** child = findChild(node, (unsigned char)key.Data()[pos]);
+		if (!child)
+			return false;
+		parentSlot = slot;
+		edge = (unsigned char)key.Data()[pos];
+		slot = child;
+		++pos;
+	}
+
+	Node* node = *slot;
+	if (!node->hasValue)
+		return false;
+	node->hasValue = false;
+	node->value = T();
+	--count;
+	//Empty nodes go away, their parent shrinks with its children and merges when it only passes through
+	if (node->children == 0 && node != root)
+	{
+		freeNode(node);
+		removeChild(*parentSlot, edge);
+		shrink(parentSlot);
+		collapse(parentSlot);
+	}
+	else
+		collapse(slot);
+	return true;
+}
+
+template<class T>
+auto	MRadixTrie<T>::Find(MStringView key) const -> T const*
+{
+	Node const*		node = root;
+	unsigned int	pos = 0;
+	for (;;)
+	{
+		unsigned int length = node->prefixLength;
+		if (key.Count() - pos < length || memcmp(prefix(node), key.Data() + pos, length) != 0)
+			return nullptr;
+		pos += length;
+		if (pos == key.Count())
+			return node->hasValue ? &node->value : nullptr;
+		Node* const* child = findChild(node, (unsigned char)key.Data()[pos]);
+		if (!child)
+			return nullptr;
+		node = *child;
+		++pos;
+	}
+}
+
+template<class T>
+auto	MRadixTrie<T>::LongestPrefix(MStringView text, unsigned int* length) const -> T const*
+{
+	T const*		found = nullptr;
+	Node const*		node = root;
+	unsigned int	pos = 0;
+	for (;;)
+	{
+		unsigned int prefixLength = node->prefixLength;
+		if (text.Count() - pos < prefixLength || memcmp(prefix(node), text.Data() + pos, prefixLength) != 0)
+			break;
+		pos += prefixLength;
+		if (node->hasValue)
+		{
+			found = &node->value;
+			if (length)
+				*length = pos;
+		}
+		if (pos == text.Count())
+			break;
+		Node* const* child = findChild(node, (unsigned char)text.Data()[pos]);
+		if (!child)
+			break;
+		node = *child;
+		++pos;
+	}
+	return found;
+}
+
+template<class T>
+template<class Callback>
+auto	MRadixTrie<T>::ForEachPrefixed(MStringView start, Callback&& callback) const -> void
+{
+	Node const*		node = root;
+	unsigned int	pos = 0;
+	//Walks down to the node whose keys all start with start, the prefix may end inside its compressed bytes
+	for (;;)
+	{
+		unsigned int common = matchPrefix(node, start, pos);
+		if (pos + common == start.Count())
+			break;
+		if (common < node->prefixLength)
+			return;
+		pos += common;
+		Node* const* child = findChild(node, (unsigned char)start.Data()[pos]);
+		if (!child)
+			return;
+		node = *child;
+		++pos;
+	}
+	MString key;
+	key.Reserve(start.Count() + 64);
+	key += start.Substr(0, pos);
+	visitTree(node, key, callback);
+}
+
+#endif /*__MRADIXTRIE_HPP__*/
@@ -0,0 +1,109 @@
+#ifndef __MSTRINGALLOCATOR_HPP__
+#define __MSTRINGALLOCATOR_HPP__
+
+#include <vector>
+
+//Memory resource for MString buffers, size always includes the terminator.
+//A MString without allocator uses new[] / delete[] directly.
+class MStringAllocator
+{
+public:
+	virtual ~MStringAllocator() = default;
+
+	virtual auto	Allocate(unsigned int size) -> char* = 0;
+	virtual auto	Deallocate(char* ptr, unsigned int size) -> void = 0;
+	//Grows or shrinks the buffer without moving it, returns false when it is not possible
+	virtual auto	Resize(char* ptr, unsigned int size, unsigned int newSize) -> bool { (void)ptr; (void)size; (void)newSize; return false; }
+};
+
+//Bump allocator for short lived strings: deallocation only gives back the most recent buffer
+//and everything else is reclaimed at once by Reset. Not thread safe, use one arena per thread.
+//Strings allocated from the arena must be destroyed or moved to the heap before Reset.
+class MStringArena : public MStringAllocator
+{
+public:
+	static const unsigned int	DefaultBlockSize = 64 * 1024;
+
+	explicit MStringArena(unsigned int blockSize = DefaultBlockSize) : blockSize(blockSize) {}
+	MStringArena(MStringArena const&) = delete;
+	auto	operator=(MStringArena const&) -> MStringArena& = delete;
+
+	~MStringArena()
+	{
+		for (Block& block : blocks)
+			delete[] block.data;
+	}
+
+	auto	Allocate(unsigned int size) -> char* override
+	{
+		if (blocks.empty() || blocks.back().size - top < size)
+			nextBlock(size);
+		char* ptr = blocks.back().data + top;
+		top += size;
+		used += size;
+		return ptr;
+	}
+
+	auto	Deallocate(char* ptr, unsigned int size) -> void override
+	{
+		if (!blocks.empty() && ptr + size == blocks.back().data + top)
+		{
+			top -= size;
+			used -= size;
+		}
+	}
+
+	//The most recent buffer can be resized in place while the block has room
+	auto	Resize(char* ptr, unsigned int size, unsigned int newSize) -> bool override
+	{
+		if (blocks.empty() || ptr + size != blocks.back().data + top || ptr + newSize > blocks.back().data + blocks.back().size)
+			return false;
+		top = top - size + newSize;
+		used = used - size + newSize;
+		return true;
+	}
+
+	//Frees every string at once, blocks are kept. When the frame needed several blocks they are
+	//merged into one large enough for the whole frame so the next one bumps in a single block.
+	auto	Reset() -> void
+	{
+		if (blocks.size() > 1)
+		{
+			unsigned int total = 0;
+			for (Block& block : blocks)
+			{
+				total += block.size;
+				delete[] block.data;
+			}
+			blocks.clear();
+			blocks.push_back(Block{ new char[total], total });
+		}
+		top = 0;
+		used = 0;
+	}
+
+	//Bytes handed out since the last Reset and not given back
+	auto	UsedBytes() const -> unsigned long long { return used; }
+
+private:
+	struct Block
+	{
+		char*			data;
+		unsigned int	size;
+	};
+
+	//Only the last block is bumped, the space left in the previous ones is lost until Reset
+	auto	nextBlock(unsigned int size) -> void
+	{
+		unsigned int blockBytes = size > blockSize ? size : blockSize;
+		blocks.push_back(Block{ new char[blockBytes], blockBytes });
+		top = 0;
+	}
+
+	std::vector<Block>	blocks;
+	unsigned int		top = 0;
+	unsigned int		blockSize;
+	unsigned long long	used = 0;
+};
+
+#endif /*__MSTRINGALLOCATOR_HPP__*/
@@ -0,0 +1,173 @@
+#ifndef __MSTRINGBUILDER_HPP__
+#define __MSTRINGBUILDER_HPP__
+
+#include <vector>
+
+#include "../String.hpp"
+
+//Collects appended pieces in chunks and materializes them in a single exact size MString
+class MStringBuilder
+{
+public:
+	static const unsigned int	LocalChunkSize = 256;
+
+	MStringBuilder() = default;
+	MStringBuilder(MStringBuilder const&) = delete;
+	auto	operator=(MStringBuilder const&) -> MStringBuilder& = delete;
+
+	~MStringBuilder()
+	{
+		for (Chunk& chunk : chunks)
+			delete[] chunk.data;
+	}
+
+	auto	Append(MStringView value) -> MStringBuilder&
+	{
+		char const*		src = value.Data();
+		unsigned int	len = value.Count();
+		count += len;
+		while (len > 0)
+		{
+			Chunk* chunk = &tail();
+			if (chunk->size == chunk->capacity)
+				chunk = &nextChunk(len);
+			unsigned int n = chunk->capacity - chunk->size;
+			if (n > len)
+				n = len;
+			memcpy(chunk->data + chunk->size, src, n);
+			chunk->size += n;
+			src += n;
+			len -= n;
+		}
+		return *this;
+	}
+
+	auto	Append(char value) -> MStringBuilder&
+	{
+		Chunk* chunk = &tail();
+		if (chunk->size == chunk->capacity)
+			chunk = &nextChunk(1);
+		chunk->data[chunk->size++] = value;
+		++count;
+		return *this;
+	}
+
+	auto	AppendInt(long long value) -> MStringBuilder&
+	{
+		char buffer[MStringNumber::MaxIntChars];
+		return Append(MStringView(buffer, MStringNumber::FormatInt(buffer, value)));
+	}
+
+	auto	AppendUInt(unsigned long long value) -> MStringBuilder&
+	{
+		char buffer[MStringNumber::MaxIntChars];
+		return Append(MStringView(buffer, MStringNumber::FormatUInt(buffer, value)));
+	}
+
+	auto	AppendFloat(float value) -> MStringBuilder&
+	{
+		char buffer[MStringNumber::MaxFloatChars];
+		return Append(MStringView(buffer, MStringNumber::FormatFloat(buffer, value)));
+	}
+
+	//Same format strings as MString::Format, written straight into the chunks
+	template<unsigned int Placeholders, unsigned int LiteralLength, class... Args>
+	auto	AppendFormat(MFormatString<Placeholders, LiteralLength> format, Args const&... args) -> MStringBuilder&
+	{
+		Chunk&			chunk = reserve(MStringFormat::Length(format, args...));
+		unsigned int	written = MStringFormat::Write(chunk.data + chunk.size, format, args...);
+		chunk.size += written;
+		count += written;
+		return *this;
+	}
+
+	auto	operator+=(MStringView value) -> MStringBuilder& { return Append(value); }
+	auto	operator+=(char value) -> MStringBuilder& { return Append(value); }
+
+	auto	Count() const -> unsigned int { return count; }
+
+	//Keeps the chunks allocated so the builder can be reused without allocating
+	auto	Clear() -> void
+	{
+		first.size = 0;
+		for (unsigned int idx = 0; idx < used; ++idx)
+			chunks[idx].size = 0;
+		used = 0;
+		count = 0;
+	}
+
+	auto	ToString(MStringAllocator* allocator = nullptr) const -> MString
+	{
+		MString ret(allocator);
+		ret.Reserve(count);
+		ret.Append(MStringView(first.data, first.size));
+		for (unsigned int idx = 0; idx < used; ++idx)
+			ret.Append(MStringView(chunks[idx].data, chunks[idx].size));
+		return ret;
+	}
+
+	//Writes at most size - 1 chars followed by a terminator, returns the number of chars written
+	auto	CopyTo(char* buffer, unsigned int size) const -> unsigned int
+	{
+		if (size == 0)
+			return 0;
+		unsigned int written = copyChunk(first, buffer, size - 1);
+		for (unsigned int idx = 0; idx < used && written < size - 1; ++idx)
+			written += copyChunk(chunks[idx], buffer + written, size - 1 - written);
+		buffer[written] = '\0';
+		return written;
+	}
+
+private:
+	struct Chunk
+	{
+		char*			data;
+		unsigned int	size;
+		unsigned int	capacity;
+	};
+
+	auto	tail() -> Chunk& { return used ? chunks[used - 1] : first; }
+
+	auto	nextChunk(unsigned int needed) -> Chunk&
+	{
+		if (used < chunks.size())
+			return chunks[used++];
+		unsigned int capacity = tail().capacity * 2;
+		if (capacity < needed)
+			capacity = needed;
+		chunks.push_back(Chunk{ new char[capacity], 0, capacity });
+		++used;
+		return chunks.back();
+	}
+
+	//Chunk with room for size contiguous chars, the end of the current tail is skipped when it is too short
+	auto	reserve(unsigned int size) -> Chunk&
+	{
+		Chunk& current = tail();
+		if (current.capacity - current.size >= size)
+			return current;
+		Chunk& chunk = nextChunk(size);
+		if (chunk.capacity < size)
+		{
+			delete[] chunk.data;
+			chunk.data = new char[size];
+			chunk.capacity = size;
+		}
+		return chunk;
+	}
+
+	static auto	copyChunk(Chunk const& chunk, char* dest, unsigned int max) -> unsigned int
+	{
+		unsigned int n = chunk.size < max ? chunk.size : max;
+		memcpy(dest, chunk.data, n);
+		return n;
+	}
+
+	char				local[LocalChunkSize];
+	Chunk				first = { local, 0, LocalChunkSize };
+	std::vector<Chunk>	chunks;
+	unsigned int		used = 0;
+	unsigned int		count = 0;
+};
+
+#endif /*__MSTRINGBUILDER_HPP__*/
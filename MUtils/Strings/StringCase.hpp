@@ -0,0 +1,163 @@
+#ifndef __MSTRINGCASE_HPP__
+#define __MSTRINGCASE_HPP__
+
+#include "StringSearch.hpp"
+
+//Locale free ASCII case conversion and case insensitive matching, bytes outside A-Z / a-z are left as is.
+//Nothing here allocates, case is folded on the fly 16 or 32 bytes at a time.
+class MStringCase
+{
+public:
+	static auto	ToLower(char c) -> char { return (unsigned char)(c - 'A') < 26 ? (char)(c | 0x20) : c; }
+	static auto	ToUpper(char c) -> char { return (unsigned char)(c - 'a') < 26 ? (char)(c & ~0x20) : c; }
+
+	static auto	ToLower(char* data, unsigned int count) -> void { flipRange(data, count, 'A'); }
+	static auto	ToUpper(char* data, unsigned int count) -> void { flipRange(data, count, 'a'); }
+
+	static auto	Equal(char const* first, unsigned int firstLen, char const* second, unsigned int secondLen) -> bool
+	{
+		if (firstLen != secondLen)
+			return false;
+		unsigned int pos = 0;
+#if defined(MSTRING_AVX2)
+		for (; pos + 32 <= firstLen; pos += 32)
+		{
+			__m256i	blockFirst = fold32(_mm256_loadu_si256((__m256i const*)(first + pos)));
+			__m256i	blockSecond = fold32(_mm256_loadu_si256((__m256i const*)(second + pos)));
+			if ((unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(blockFirst, blockSecond)) != 0xFFFFFFFF)
+				return false;
+		}
+#endif
+#if defined(MSTRING_SSE2)
+		for (; pos + 16 <= firstLen; pos += 16)
+		{
+			__m128i	blockFirst = fold16(_mm_loadu_si128((__m128i const*)(first + pos)));
+			__m128i	blockSecond = fold16(_mm_loadu_si128((__m128i const*)(second + pos)));
+			if (_mm_movemask_epi8(_mm_cmpeq_epi8(blockFirst, blockSecond)) != 0xFFFF)
+				return false;
+		}
+#endif
+		for (; pos < firstLen; ++pos)
+		{
+			if (ToLower(first[pos]) != ToLower(second[pos]))
+				return false;
+		}
+		return true;
+	}
+
+	//Orders as if both sides were lowered
+	static auto	Compare(char const* first, unsigned int firstLen, char const* second, unsigned int secondLen) -> int
+	{
+		unsigned int	minLen = firstLen < secondLen ? firstLen : secondLen;
+		unsigned int	pos = 0;
+#if defined(MSTRING_SSE2)
+		for (; pos + 16 <= minLen; pos += 16)
+		{
+			__m128i			blockFirst = fold16(_mm_loadu_si128((__m128i const*)(first + pos)));
+			__m128i			blockSecond = fold16(_mm_loadu_si128((__m128i const*)(second + pos)));
+			unsigned int	diff = ~(unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(blockFirst, blockSecond)) & 0xFFFF;
+			if (diff != 0)
+			{
+				pos += MStringSearch::LowestBit(diff);
+				break;
+			}
+		}
+#endif
+		for (; pos < minLen; ++pos)
+		{
+			unsigned char	charFirst = (unsigned char)ToLower(first[pos]);
+			unsigned char	charSecond = (unsigned char)ToLower(second[pos]);
+			if (charFirst != charSecond)
+				return charFirst < charSecond ? -1 : 1;
+		}
+		return firstLen < secondLen ? -1 : (firstLen > secondLen ? 1 : 0);
+	}
+
+	static auto	Find(char const* hay, unsigned int hayLen, char const* needle, unsigned int needleLen, unsigned int from = 0) -> unsigned int
+	{
+		if (from > hayLen || needleLen > hayLen - from)
+			return MStringSearch::NotFound;
+		if (needleLen == 0)
+			return from;
+
+		unsigned int	last = hayLen - needleLen;
+		unsigned int	pos = from;
+		char			firstChar = ToLower(needle[0]);
+		char			lastChar = ToLower(needle[needleLen - 1]);
+#if defined(MSTRING_SSE2)
+		__m128i	first16 = _mm_set1_epi8(firstChar);
+		__m128i	last16 = _mm_set1_epi8(lastChar);
+		for (; pos + 16 <= last + 1; pos += 16)
+		{
+			__m128i			blockFirst = fold16(_mm_loadu_si128((__m128i const*)(hay + pos)));
+			__m128i			blockLast = fold16(_mm_loadu_si128((__m128i const*)(hay + pos + needleLen - 1)));
+			unsigned int	mask = (unsigned int)_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(blockFirst, first16), _mm_cmpeq_epi8(blockLast, last16)));
+			for (; mask != 0; mask &= mask - 1)
+			{
+				unsigned int candidate = pos + MStringSearch::LowestBit(mask);
+				if (Equal(hay + candidate, needleLen, needle, needleLen))
+					return candidate;
+			}
+		}
+#endif
+		for (; pos <= last; ++pos)
+		{
+			if (ToLower(hay[pos]) == firstChar && ToLower(hay[pos + needleLen - 1]) == lastChar && Equal(hay + pos, needleLen, needle, needleLen))
+				return pos;
+		}
+		return MStringSearch::NotFound;
+	}
+
+private:
+	friend class MStringFold;
+
+	//Flips the 0x20 bit of the 26 chars starting at first
+	static auto	flipRange(char* data, unsigned int count, char first) -> void
+	{
+		unsigned int pos = 0;
+#if defined(MSTRING_AVX2)
+		for (; pos + 32 <= count; pos += 32)
+		{
+			__m256i block = _mm256_loadu_si256((__m256i const*)(data + pos));
+			_mm256_storeu_si256((__m256i*)(data + pos), flip32(block, first));
+		}
+#endif
+#if defined(MSTRING_SSE2)
+		for (; pos + 16 <= count; pos += 16)
+		{
+			__m128i block = _mm_loadu_si128((__m128i const*)(data + pos));
+			_mm_storeu_si128((__m128i*)(data + pos), flip16(block, first));
+		}
+#endif
+		for (; pos < count; ++pos)
+		{
+			if ((unsigned char)(data[pos] - first) < 26)
+				data[pos] ^= 0x20;
+		}
+	}
+
+#if defined(MSTRING_SSE2)
+	//Shifting by 0x80 - first moves the 26 letters to the bottom of the signed range, where one signed compare finds them
+	static auto	flip16(__m128i block, char first) -> __m128i
+	{
+		__m128i shifted = _mm_add_epi8(block, _mm_set1_epi8((char)(0x80 - first)));
+		__m128i inRange = _mm_cmplt_epi8(shifted, _mm_set1_epi8((char)(0x80 + 26)));
+		return _mm_xor_si128(block, _mm_and_si128(inRange, _mm_set1_epi8(0x20)));
+	}
+
+	static auto	fold16(__m128i block) -> __m128i { return flip16(block, 'A'); }
+#endif
+
+#if defined(MSTRING_AVX2)
+	static auto	flip32(__m256i block, char first) -> __m256i
+	{
+		__m256i shifted = _mm256_add_epi8(block, _mm256_set1_epi8((char)(0x80 - first)));
+		__m256i inRange = _mm256_cmpgt_epi8(_mm256_set1_epi8((char)(0x80 + 26)), shifted);
+		return _mm256_xor_si256(block, _mm256_and_si256(inRange, _mm256_set1_epi8(0x20)));
+	}
+
+	static auto	fold32(__m256i block) -> __m256i { return flip32(block, 'A'); }
+#endif
+};
+
+#endif /*__MSTRINGCASE_HPP__*/
@@ -0,0 +1,140 @@
+#ifndef __MSTRINGCONCAT_HPP__
+#define __MSTRINGCONCAT_HPP__
+
+#include <cstring>
+#include <utility>
+
+#include "StringAllocator.hpp"
+#include "StringView.hpp"
+
+class MString;
+
+//One operand of a concatenation, a view or a single char kept by value
+class MStringPiece
+{
+public:
+	MStringPiece(MStringView view) : data(view.Data()), count(view.Count()) {}
+	MStringPiece(char value) : value(value) {}
+
+	auto	Data() const -> char const* { return data; }
+	auto	Count() const -> unsigned int { return count; }
+	auto	First() const -> MStringPiece const& { return *this; }
+
+	auto	Write(char* out, bool skipFirst = false) const -> char*
+	{
+		if (skipFirst)
+			return out;
+		if (data)
+			memcpy(out, data, count);
+		else if (count)
+			*out = value;
+		return out + count;
+	}
+
+	auto	Overlaps(char const* begin, char const* end) const -> bool { return data && data < end && data + count > begin; }
+
+	//Compares the piece with text from pos and moves pos after it, returns nonzero at the first difference
+	auto	CompareAt(MStringView text, unsigned int& pos) const -> int
+	{
+		unsigned int	left = text.Count() - pos;
+		unsigned int	size = count < left ? count : left;
+		int				res = size ? memcmp(data ? data : &value, text.Data() + pos, size) : 0;
+		if (res != 0)
+			return res;
+		if (count > left)
+			return 1;
+		pos += count;
+		return 0;
+	}
+
+private:
+	char const*		data = nullptr;
+	unsigned int	count = 1;
+	char			value = '\0';
+};
+
+//Result of a + b + ... with MString operands. Nothing is copied until it becomes a MString: the lengths
+//are summed, one buffer is allocated and every operand is written once.
+//Operands are referenced and not copied, so a concatenation only lives until the end of its expression. Since C++17
+//auto s = a + b compiles whatever the constructors are, every member is rvalue only instead: a named concatenation
+//can't be converted, compared or extended, store the result in a MString or call ToString.
+//There is no buffer to point at either, Str() does not compile and (a + b).ToString().Str() is the replacement.
+//Comparisons walk the operands without building the result.
+template<class Left, class Right>
+class MStringConcat
+{
+public:
+	MStringConcat(Left const& left, Right const& right) : left(left), right(right) {}
+
+	//The result is allocated from allocator, nullptr for the heap. Defined after MString.
+	auto	ToString(MStringAllocator* allocator = nullptr) && -> MString;
+	auto	Str() const -> char const* = delete;
+
+	//Same order as MStringView
+	auto	Compare(MStringView other) && -> int { return compare(other); }
+
+	bool	operator==(MStringView other) && { return Count() == other.Count() && compare(other) == 0; }
+	bool	operator!=(MStringView other) && { return Count() != other.Count() || compare(other) != 0; }
+	bool	operator<(MStringView other) && { return compare(other) < 0; }
+
+	friend bool	operator==(MStringView first, MStringConcat&& second) { return std::move(second) == first; }
+	friend bool	operator!=(MStringView first, MStringConcat&& second) { return std::move(second) != first; }
+
+	auto	operator+(MStringView other) && -> MStringConcat<MStringConcat, MStringPiece>
+	{
+		return { *this, other };
+	}
+
+	auto	operator+(char other) && -> MStringConcat<MStringConcat, MStringPiece>
+	{
+		return { *this, other };
+	}
+
+	template<class OtherLeft, class OtherRight>
+	auto	operator+(MStringConcat<OtherLeft, OtherRight>&& other) && -> MStringConcat<MStringConcat, MStringConcat<OtherLeft, OtherRight>>
+	{
+		return { *this, other };
+	}
+
+	friend auto	operator+(char const* first, MStringConcat&& second) -> MStringConcat<MStringPiece, MStringConcat>
+	{
+		return { MStringView(first), second };
+	}
+
+private:
+	//Operators return braced results, only nested concatenations copy one
+	template<class, class>
+	friend class MStringConcat;
+	friend class MString;
+
+	MStringConcat(MStringConcat const&) = default;
+	auto	operator=(MStringConcat const&) -> MStringConcat& = delete;
+
+	//Same interface as MStringPiece, used on the operands and by MString
+	auto	Count() const -> unsigned int { return left.Count() + right.Count(); }
+	auto	First() const -> MStringPiece const& { return left.First(); }
+
+	//Writes every operand but the first when skipFirst is set, without terminator. Returns the end of the written chars.
+	auto	Write(char* out, bool skipFirst = false) const -> char* { return right.Write(left.Write(out, skipFirst)); }
+
+	//True when an operand points inside [begin, end)
+	auto	Overlaps(char const* begin, char const* end) const -> bool { return left.Overlaps(begin, end) || right.Overlaps(begin, end); }
+
+	auto	CompareAt(MStringView text, unsigned int& pos) const -> int
+	{
+		int res = left.CompareAt(text, pos);
+		return res != 0 ? res : right.CompareAt(text, pos);
+	}
+
+	auto	compare(MStringView other) const -> int
+	{
+		unsigned int	pos = 0;
+		int				res = CompareAt(other, pos);
+		return res != 0 ? res : pos < other.Count() ? -1 : 0;
+	}
+
+	Left	left;
+	Right	right;
+};
+
+#endif /*__MSTRINGCONCAT_HPP__*/
@@ -0,0 +1,173 @@
+#ifndef __MSTRINGFOLD_HPP__
+#define __MSTRINGFOLD_HPP__
+
+#include "StringCase.hpp"
+#include "StringHash.hpp"
+#include "StringUTF.hpp"
+
+//Unicode simple case folding over UTF-8, every code point folds to a single code point so no locale or
+//context is involved. Runs of ASCII are folded 16 bytes at a time, other code points go through a two
+//level table. Ill formed bytes are kept as is and only match the same bytes.
+class MStringFold
+{
+public:
+	static auto	Fold(unsigned int codePoint) -> unsigned int
+	{
+		if (codePoint > MaxFolded)
+			return codePoint;
+		unsigned int block = foldIndex[codePoint >> BlockBits];
+		return codePoint + foldDeltas[foldBlocks[(block << BlockBits) | (codePoint & (BlockSize - 1))]];
+	}
+
+	//Folding can change the encoded length of a code point, this gives the exact size FoldTo writes
+	static auto	FoldedLength(char const* str, unsigned int count) -> unsigned int
+	{
+		unsigned int	pos = 0;
+		unsigned int	length = 0;
+		while (pos < count)
+		{
+#ifdef MSTRING_SSE2
+			if (pos + 16 <= count && _mm_movemask_epi8(_mm_loadu_si128((__m128i const*)(str + pos))) == 0)
+			{
+				pos += 16;
+				length += 16;
+				continue;
+			}
+#endif
+			if ((unsigned char)str[pos] < 0x80)
+			{
+				++pos;
+				++length;
+				continue;
+			}
+			char			encoded[4];
+			unsigned int	codePoint;
+			unsigned int	used = MStringUTF::DecodeUTF8(str + pos, count - pos, codePoint);
+			length += codePoint == MStringUTF::InvalidCodePoint ? used : MStringUTF::EncodeUTF8(Fold(codePoint), encoded);
+			pos += used;
+		}
+		return length;
+	}
+
+	//out must hold FoldedLength chars, no terminator is written. Returns the number of chars written.
+	static auto	FoldTo(char const* str, unsigned int count, char* out) -> unsigned int
+	{
+		unsigned int pos = 0;
+		return foldRun(str, count, pos, out, 0xFFFFFFFF);
+	}
+
+	static auto	Equal(char const* first, unsigned int firstLen, char const* second, unsigned int secondLen) -> bool
+	{
+		unsigned int	firstPos = 0;
+		unsigned int	secondPos = 0;
+		while (firstPos < firstLen && secondPos < secondLen)
+		{
+#ifdef MSTRING_SSE2
+			if (firstPos + 16 <= firstLen && secondPos + 16 <= secondLen)
+			{
+				__m128i	firstBlock = _mm_loadu_si128((__m128i const*)(first + firstPos));
+				__m128i	secondBlock = _mm_loadu_si128((__m128i const*)(second + secondPos));
+				if (_mm_movemask_epi8(_mm_or_si128(firstBlock, secondBlock)) == 0)
+				{
+					__m128i equal = _mm_cmpeq_epi8(MStringCase::fold16(firstBlock), MStringCase::fold16(secondBlock));
+					if (_mm_movemask_epi8(equal) != 0xFFFF)
+						return false;
+					firstPos += 16;
+					secondPos += 16;
+					continue;
+				}
+			}
+#endif
+			unsigned int	firstCode;
+			unsigned int	secondCode;
+			unsigned int	firstUsed = MStringUTF::DecodeUTF8(first + firstPos, firstLen - firstPos, firstCode);
+			unsigned int	secondUsed = MStringUTF::DecodeUTF8(second + secondPos, secondLen - secondPos, secondCode);
+			if (firstCode == MStringUTF::InvalidCodePoint || secondCode == MStringUTF::InvalidCodePoint)
+			{
+				if (firstCode != secondCode || firstUsed != secondUsed || memcmp(first + firstPos, second + secondPos, firstUsed) != 0)
+					return false;
+			}
+			else if (Fold(firstCode) != Fold(secondCode))
+				return false;
+			firstPos += firstUsed;
+			secondPos += secondUsed;
+		}
+		return firstPos == firstLen && secondPos == secondLen;
+	}
+
+	//Consistent with Equal, strings that compare equal hash the same. The folded text is hashed in chunks
+	//of ChunkSize bytes, so for shorter strings this is MStringHash::Hash of the folded string.
+	static auto	Hash(char const* str, unsigned int count) -> unsigned long long
+	{
+		char				buffer[ChunkSize + 16];
+		unsigned int		pos = 0;
+		unsigned int		used = 0;
+		unsigned long long	hash = MStringHash::DefaultSeed;
+		bool				chained = false;
+		for (;;)
+		{
+			used += foldRun(str, count, pos, buffer + used, ChunkSize - used);
+			if (used < ChunkSize)
+				break;
+			hash = MStringHash::Hash(buffer, ChunkSize, hash);
+			chained = true;
+			used -= ChunkSize;
+			memmove(buffer, buffer + ChunkSize, used);
+		}
+		return used || !chained ? MStringHash::Hash(buffer, used, hash) : hash;
+	}
+
+private:
+	static const unsigned int	ChunkSize = 256;
+	static const unsigned int	MaxFolded = 0x1E921;
+	static const unsigned int	BlockBits = 6;
+	static const unsigned int	BlockSize = 1 << BlockBits;
+	static const unsigned int	IndexSize = (MaxFolded >> BlockBits) + 1;
+	static const unsigned int	BlockCount = 55;
+	static const unsigned int	DeltaCount = 99;
+
+	//Folds from pos until the end of str or until at least limit chars were written, which can then be
+	//exceeded by up to 15 chars. pos is left after the last folded byte.
+	static auto	foldRun(char const* str, unsigned int count, unsigned int& pos, char* out, unsigned int limit) -> unsigned int
+	{
+		unsigned int written = 0;
+		while (pos < count && written < limit)
+		{
+#ifdef MSTRING_SSE2
+			if (pos + 16 <= count)
+			{
+				__m128i block = _mm_loadu_si128((__m128i const*)(str + pos));
+				if (_mm_movemask_epi8(block) == 0)
+				{
+					_mm_storeu_si128((__m128i*)(out + written), MStringCase::fold16(block));
+					pos += 16;
+					written += 16;
+					continue;
+				}
+			}
+#endif
+			if ((unsigned char)str[pos] < 0x80)
+			{
+				out[written++] = MStringCase::ToLower(str[pos++]);
+				continue;
+			}
+			unsigned int	codePoint;
+			unsigned int	used = MStringUTF::DecodeUTF8(str + pos, count - pos, codePoint);
+			if (codePoint == MStringUTF::InvalidCodePoint)
+			{
+				memcpy(out + written, str + pos, used);
+				written += used;
+			}
+			else
+				written += MStringUTF::EncodeUTF8(Fold(codePoint), out + written);
+			pos += used;
+		}
+		return written;
+	}
+
+	static const unsigned char	foldIndex[IndexSize];
+	static const unsigned char	foldBlocks[BlockCount * BlockSize];
+	static const int			foldDeltas[DeltaCount];
+};
+
+#endif /*__MSTRINGFOLD_HPP__*/
@@ -0,0 +1,213 @@
+#ifndef __MSTRINGFORMAT_HPP__
+#define __MSTRINGFORMAT_HPP__
+
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+#include "StringNumber.hpp"
+#include "StringView.hpp"
+
+//Format string checked at compile time, build it with MFORMAT("...{}...").
+//Each {} takes the next argument, {{ and }} are literal braces.
+template<unsigned int Placeholders, unsigned int LiteralLength>
+struct MFormatString
+{
+	constexpr MFormatString(char const* text, unsigned int count) : Text(text), Count(count) {}
+
+	char const*		Text;
+	unsigned int	Count;
+};
+
+//Specialize for a type to make it usable as a format argument:
+//	static auto	Length(T const&) -> unsigned int;			at least the number of chars Write produces, exact when cheap
+//	static auto	Write(char* out, T const&) -> unsigned int;	writes without terminator, returns the number of chars written
+template<class T>
+struct MFormatter
+{
+	static_assert(sizeof(T) == 0, "No MFormatter specialization for this argument type");
+};
+
+class MStringFormat
+{
+public:
+	static const unsigned int	InvalidFormat = 0xFFFFFFFF;
+
+	//Number of {} in format, InvalidFormat when a brace is neither a placeholder nor escaped
+	static constexpr auto	Placeholders(char const* format, unsigned int found = 0) -> unsigned int
+	{
+		return *format == '\0' ? found
+			: *format == '{' ? (format[1] == '{' ? Placeholders(format + 2, found) : format[1] == '}' ? Placeholders(format + 2, found + 1) : InvalidFormat)
+			: *format == '}' ? (format[1] == '}' ? Placeholders(format + 2, found) : InvalidFormat)
+			: Placeholders(format + 1, found);
+	}
+
+	//Chars written for format besides the arguments, only meaningful when Placeholders is valid
+	static constexpr auto	LiteralLength(char const* format, unsigned int length = 0) -> unsigned int
+	{
+		return *format == '\0' ? length
+			: *format == '{' && format[1] == '}' ? LiteralLength(format + 2, length)
+			: *format == '{' || *format == '}' ? (format[1] == '\0' ? length : LiteralLength(format + 2, length + 1))
+			: LiteralLength(format + 1, length + 1);
+	}
+
+	static constexpr auto	TextLength(char const* format, unsigned int length = 0) -> unsigned int
+	{
+		return *format == '\0' ? length : TextLength(format + 1, length + 1);
+	}
+
+	//Size to reserve before Write, exact unless an argument only gives an upper bound (floats)
+	template<unsigned int Placeholders, unsigned int LiteralLength, class... Args>
+	static auto	Length(MFormatString<Placeholders, LiteralLength> format, Args const&... args) -> unsigned int
+	{
+		check<Placeholders, sizeof...(Args)>();
+		(void)format;
+		return LiteralLength + argsLength(args...);
+	}
+
+	//out must hold Length chars, no terminator is written. Returns the number of chars written.
+	template<unsigned int Placeholders, unsigned int LiteralLength, class... Args>
+	static auto	Write(char* out, MFormatString<Placeholders, LiteralLength> format, Args const&... args) -> unsigned int
+	{
+		check<Placeholders, sizeof...(Args)>();
+		char const* text = format.Text;
+		return writeArgs(out, text, text + format.Count, args...);
+	}
+
+	//Text of a single value through its MFormatter, for the APIs returning std::string
+	template<class T>
+	static auto	ToStdString(T const& value) -> std::string
+	{
+		std::string ret(MFormatter<T>::Length(value), '\0');
+		ret.resize(MFormatter<T>::Write(&ret[0], value));
+		return ret;
+	}
+
+private:
+	template<unsigned int Placeholders, unsigned int Arguments>
+	static auto	check() -> void
+	{
+		static_assert(Placeholders != InvalidFormat, "Unmatched brace in format string, write {{ and }} for literal braces");
+		static_assert(Placeholders == Arguments, "Format string placeholders do not match the number of arguments");
+	}
+
+	template<class T>
+	using formatter = MFormatter<typename std::decay<T>::type>;
+
+	static auto	argsLength() -> unsigned int { return 0; }
+
+	template<class First, class... Rest>
+	static auto	argsLength(First const& first, Rest const&... rest) -> unsigned int
+	{
+		return formatter<First>::Length(first) + argsLength(rest...);
+	}
+
+	//Copies the literal text up to the next placeholder, which is consumed, or up to the end of the format
+	static auto	writeLiteral(char* out, char const*& text, char const* end) -> unsigned int
+	{
+		unsigned int written = 0;
+		while (text != end)
+		{
+			char c = *text;
+			if (c == '{' || c == '}')
+			{
+				text += 2;
+				if (c == '{' && text[-1] == '}')
+					return written;
+			}
+			else
+				++text;
+			out[written++] = c;
+		}
+		return written;
+	}
+
+	static auto	writeArgs(char* out, char const*& text, char const* end) -> unsigned int { return writeLiteral(out, text, end); }
+
+	template<class First, class... Rest>
+	static auto	writeArgs(char* out, char const*& text, char const* end, First const& first, Rest const&... rest) -> unsigned int
+	{
+		unsigned int written = writeLiteral(out, text, end);
+		written += formatter<First>::Write(out + written, first);
+		return written + writeArgs(out + written, text, end, rest...);
+	}
+};
+
+//Format strings have to be literals so they can be checked, the constexpr recursion is one call per char
+#define MFORMAT(format) MFormatString<MStringFormat::Placeholders(format), MStringFormat::LiteralLength(format)>(format, MStringFormat::TextLength(format))
+
+template<>
+struct MFormatter<MStringView>
+{
+	static auto	Length(MStringView value) -> unsigned int { return value.Count(); }
+	static auto	Write(char* out, MStringView value) -> unsigned int
+	{
+		memcpy(out, value.Data(), value.Count());
+		return value.Count();
+	}
+};
+
+template<>
+struct MFormatter<char const*>
+{
+	static auto	Length(char const* value) -> unsigned int { return (unsigned int)strlen(value); }
+	static auto	Write(char* out, char const* value) -> unsigned int { return MFormatter<MStringView>::Write(out, MStringView(value)); }
+};
+
+template<>
+struct MFormatter<char*> : MFormatter<char const*> {};
+
+template<>
+struct MFormatter<char>
+{
+	static auto	Length(char) -> unsigned int { return 1; }
+	static auto	Write(char* out, char value) -> unsigned int
+	{
+		*out = value;
+		return 1;
+	}
+};
+
+template<>
+struct MFormatter<bool>
+{
+	static auto	Length(bool value) -> unsigned int { return value ? 4 : 5; }
+	static auto	Write(char* out, bool value) -> unsigned int
+	{
+		memcpy(out, value ? "true" : "false", Length(value));
+		return Length(value);
+	}
+};
+
+struct MSignedFormatter
+{
+	static auto	Length(long long value) -> unsigned int { return MStringNumber::IntLength(value); }
+	static auto	Write(char* out, long long value) -> unsigned int { return MStringNumber::FormatInt(out, value); }
+};
+
+struct MUnsignedFormatter
+{
+	static auto	Length(unsigned long long value) -> unsigned int { return MStringNumber::UIntLength(value); }
+	static auto	Write(char* out, unsigned long long value) -> unsigned int { return MStringNumber::FormatUInt(out, value); }
+};
+
+template<> struct MFormatter<signed char> : MSignedFormatter {};
+template<> struct MFormatter<short> : MSignedFormatter {};
+template<> struct MFormatter<int> : MSignedFormatter {};
+template<> struct MFormatter<long> : MSignedFormatter {};
+template<> struct MFormatter<long long> : MSignedFormatter {};
+template<> struct MFormatter<unsigned char> : MUnsignedFormatter {};
+template<> struct MFormatter<unsigned short> : MUnsignedFormatter {};
+template<> struct MFormatter<unsigned int> : MUnsignedFormatter {};
+template<> struct MFormatter<unsigned long> : MUnsignedFormatter {};
+template<> struct MFormatter<unsigned long long> : MUnsignedFormatter {};
+
+//Shortest round trip text, the exact length would cost a second conversion so the maximum is reserved
+template<>
+struct MFormatter<float>
+{
+	static auto	Length(float) -> unsigned int { return MStringNumber::MaxFloatChars; }
+	static auto	Write(char* out, float value) -> unsigned int { return MStringNumber::FormatFloat(out, value); }
+};
+
+#endif /*__MSTRINGFORMAT_HPP__*/
@@ -0,0 +1,211 @@
+#ifndef __MSTRINGHASH_HPP__
+#define __MSTRINGHASH_HPP__
+
+#include <cstring>
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+//Fast non cryptographic 64 bits hash (wyhash final4) over an explicit length, '\0' is hashed like any other byte.
+//Values are only stable for a given endianness, do not persist them across platforms.
+class MStringHash
+{
+public:
+	static const unsigned long long	DefaultSeed = 0;
+
+	static auto	Hash(char const* data, unsigned int count, unsigned long long seed = DefaultSeed) -> unsigned long long
+	{
+		unsigned char const*	p = (unsigned char const*)data;
+		unsigned long long		a;
+		unsigned long long		b;
+
+		seed ^= mix(seed ^ Secret0, Secret1);
+		if (count <= 16)
+		{
+			if (count >= 4)
+			{
+				unsigned int shift = (count >> 3) << 2;
+				a = (read4(p) << 32) | read4(p + shift);
+				b = (read4(p + count - 4) << 32) | read4(p + count - 4 - shift);
+			}
+			else if (count > 0)
+			{
+				a = ((unsigned long long)p[0] << 16) | ((unsigned long long)p[count >> 1] << 8) | p[count - 1];
+				b = 0;
+			}
+			else
+				a = b = 0;
+		}
+		else
+		{
+			unsigned int left = count;
+			if (left > 48)
+			{
+				unsigned long long	seed1 = seed;
+				unsigned long long	seed2 = seed;
+				do
+				{
+					seed = mix(read8(p) ^ Secret1, read8(p + 8) ^ seed);
+					seed1 = mix(read8(p + 16) ^ Secret2, read8(p + 24) ^ seed1);
+					seed2 = mix(read8(p + 32) ^ Secret3, read8(p + 40) ^ seed2);
+					p += 48;
+					left -= 48;
+				} while (left > 48);
+				seed ^= seed1 ^ seed2;
+			}
+			for (; left > 16; left -= 16, p += 16)
+				seed = mix(read8(p) ^ Secret1, read8(p + 8) ^ seed);
+			a = read8(p + left - 16);
+			b = read8(p + left - 8);
+		}
+		a ^= Secret1;
+		b ^= seed;
+		multiply(a, b);
+		return mix(a ^ Secret0 ^ count, b ^ Secret1);
+	}
+
+	static auto	Hash(char const* str) -> unsigned long long { return Hash(str, (unsigned int)strlen(str)); }
+
+	//Same value as Hash on little endian targets, and usable in constant expressions, see operator"" _mh.
+	//Written as single return functions so older compilers can evaluate it, recursing once per 16 bytes.
+	static constexpr auto	ConstHash(char const* data, unsigned int count, unsigned long long seed = DefaultSeed) -> unsigned long long
+	{
+		return constHash(data, count, seed ^ constMix(seed ^ Secret0, Secret1));
+	}
+
+	//True when no two hashes are equal, to static_assert that the case labels of a switch do not collide
+	static constexpr auto	Distinct(unsigned long long) -> bool { return true; }
+
+	template<class... Rest>
+	static constexpr auto	Distinct(unsigned long long first, unsigned long long second, Rest... rest) -> bool
+	{
+		return differs(first, second, rest...) && Distinct(second, rest...);
+	}
+
+private:
+	static const unsigned long long	Secret0 = 0x2d358dccaa6c78a5ull;
+	static const unsigned long long	Secret1 = 0x8bb84b93962eacc9ull;
+	static const unsigned long long	Secret2 = 0x4b33a62ed433d4a3ull;
+	static const unsigned long long	Secret3 = 0x4d5a2da51de1aa47ull;
+
+	//Full 128 bits product, low half in a and high half in b
+	static auto	multiply(unsigned long long& a, unsigned long long& b) -> void
+	{
+#if defined(__SIZEOF_INT128__)
+		unsigned __int128 product = (unsigned __int128)a * b;
+		a = (unsigned long long)product;
+		b = (unsigned long long)(product >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+		a = _umul128(a, b, &b);
+#else
+		unsigned long long	aHigh = a >> 32;
+		unsigned long long	aLow = (unsigned int)a;
+		unsigned long long	bHigh = b >> 32;
+		unsigned long long	bLow = (unsigned int)b;
+		unsigned long long	high = aHigh * bHigh;
+		unsigned long long	middle0 = aHigh * bLow;
+		unsigned long long	middle1 = aLow * bHigh;
+		unsigned long long	low = aLow * bLow;
+		unsigned long long	t = low + (middle0 << 32);
+		unsigned long long	carry = t < low;
+		unsigned long long	lo = t + (middle1 << 32);
+		carry += lo < t;
+		a = lo;
+		b = high + (middle0 >> 32) + (middle1 >> 32) + carry;
+#endif
+	}
+
+	static auto	mix(unsigned long long a, unsigned long long b) -> unsigned long long
+	{
+		multiply(a, b);
+		return a ^ b;
+	}
+
+	static auto	read8(unsigned char const* p) -> unsigned long long
+	{
+		unsigned long long value;
+		memcpy(&value, p, sizeof(value));
+		return value;
+	}
+
+	static auto	read4(unsigned char const* p) -> unsigned long long
+	{
+		unsigned int value;
+		memcpy(&value, p, sizeof(value));
+		return value;
+	}
+
+	//Compile time counterparts, bytes are assembled in little endian order
+	static constexpr auto	constByte(char const* p, unsigned int idx) -> unsigned long long { return (unsigned char)p[idx]; }
+
+	static constexpr auto	constRead4(char const* p) -> unsigned long long
+	{
+		return constByte(p, 0) | (constByte(p, 1) << 8) | (constByte(p, 2) << 16) | (constByte(p, 3) << 24);
+	}
+
+	static constexpr auto	constRead8(char const* p) -> unsigned long long { return constRead4(p) | (constRead4(p + 4) << 32); }
+
+	static constexpr auto	constCarry(unsigned long long low, unsigned long long middle0, unsigned long long middle1) -> unsigned long long
+	{
+		return (unsigned long long)(low + middle0 < low) + (unsigned long long)(low + middle0 + middle1 < low + middle0);
+	}
+
+	static constexpr auto	constHighSum(unsigned long long high, unsigned long long middle0, unsigned long long middle1, unsigned long long low) -> unsigned long long
+	{
+		return high + (middle0 >> 32) + (middle1 >> 32) + constCarry(low, middle0 << 32, middle1 << 32);
+	}
+
+	//High half of the 128 bits product, the low half is a * b
+	static constexpr auto	constMulHigh(unsigned long long a, unsigned long long b) -> unsigned long long
+	{
+		return constHighSum((a >> 32) * (b >> 32), (a >> 32) * (b & 0xFFFFFFFF), (a & 0xFFFFFFFF) * (b >> 32), (a & 0xFFFFFFFF) * (b & 0xFFFFFFFF));
+	}
+
+	static constexpr auto	constMix(unsigned long long a, unsigned long long b) -> unsigned long long { return (a * b) ^ constMulHigh(a, b); }
+
+	static constexpr auto	constFinish(unsigned long long a, unsigned long long b, unsigned int count) -> unsigned long long
+	{
+		return constMix((a * b) ^ Secret0 ^ count, constMulHigh(a, b) ^ Secret1);
+	}
+
+	static constexpr auto	constHash(char const* p, unsigned int count, unsigned long long seed) -> unsigned long long
+	{
+		return count > 48 ? constLoop48(p, count, seed, seed, seed, count)
+			: count > 16 ? constLoop16(p, count, seed, count)
+			: count >= 4 ? constFinish(((constRead4(p) << 32) | constRead4(p + ((count >> 3) << 2))) ^ Secret1,
+				((constRead4(p + count - 4) << 32) | constRead4(p + count - 4 - ((count >> 3) << 2))) ^ seed, count)
+			: count > 0 ? constFinish(((constByte(p, 0) << 16) | (constByte(p, count >> 1) << 8) | constByte(p, count - 1)) ^ Secret1, seed, count)
+			: constFinish(Secret1, seed, count);
+	}
+
+	static constexpr auto	constLoop48(char const* p, unsigned int left, unsigned long long seed, unsigned long long seed1, unsigned long long seed2, unsigned int count) -> unsigned long long
+	{
+		return left > 48 ? constLoop48(p + 48, left - 48, constMix(constRead8(p) ^ Secret1, constRead8(p + 8) ^ seed),
+				constMix(constRead8(p + 16) ^ Secret2, constRead8(p + 24) ^ seed1), constMix(constRead8(p + 32) ^ Secret3, constRead8(p + 40) ^ seed2), count)
+			: constLoop16(p, left, seed ^ seed1 ^ seed2, count);
+	}
+
+	static constexpr auto	constLoop16(char const* p, unsigned int left, unsigned long long seed, unsigned int count) -> unsigned long long
+	{
+		return left > 16 ? constLoop16(p + 16, left - 16, constMix(constRead8(p) ^ Secret1, constRead8(p + 8) ^ seed), count)
+			: constFinish(constRead8(p + left - 16) ^ Secret1, constRead8(p + left - 8) ^ seed, count);
+	}
+
+	static constexpr auto	differs(unsigned long long) -> bool { return true; }
+
+	template<class... Rest>
+	static constexpr auto	differs(unsigned long long value, unsigned long long first, Rest... rest) -> bool
+	{
+		return value != first && differs(value, rest...);
+	}
+};
+
+//"name"_mh is the MStringHash::Hash of the literal computed at compile time, so it can label a switch case:
+//	switch (command.Hash()) { case "quit"_mh: if (command == "quit") ... }
+constexpr auto	operator"" _mh(char const* str, size_t length) -> unsigned long long
+{
+	return MStringHash::ConstHash(str, (unsigned int)length);
+}
+
+#endif /*__MSTRINGHASH_HPP__*/
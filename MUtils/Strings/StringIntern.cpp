@@ -0,0 +1,222 @@
+#include <cassert>
+#include <mutex>
+
+#include "StringIntern.hpp"
+
+MStringInternTable::MStringInternTable()
+{
+	for (Shard& shard : shards)
+	{
+		for (std::atomic<char const**>& segment : shard.segments)
+			segment.store(nullptr, std::memory_order_relaxed);
+		shard.requests.store(0, std::memory_order_relaxed);
+		shard.requestedBytes.store(0, std::memory_order_relaxed);
+		shard.slots.resize(64, Slot{ 0, MStringId::Invalid });
+	}
+}
+
+
+MStringInternTable::~MStringInternTable()
+{
+	for (Shard& shard : shards)
+	{
+		for (std::atomic<char const**>& segment : shard.segments)
+			delete[] segment.load(std::memory_order_relaxed);
+		for (char* block : shard.blocks)
+			delete[] block;
+	}
+}
+
+
+auto	MStringInternTable::Intern(MStringView str) -> MStringId
+{
+	unsigned int	hash = hashOf(str);
+	Shard&			shard = shards[hash & (ShardCount - 1)];
+
+	shard.requests.fetch_add(1, std::memory_order_relaxed);
+	shard.requestedBytes.fetch_add(str.Count() + 1, std::memory_order_relaxed);
+	{
+		std::shared_lock<std::shared_timed_mutex> lock(shard.mutex);
+		MStringId id = find(shard, str, hash);
+		if (id.IsValid())
+			return id;
+	}
+
+	std::unique_lock<std::shared_timed_mutex> lock(shard.mutex);
+	MStringId id = find(shard, str, hash);
+	if (id.IsValid())
+		return id;
+	return insert(shard, str, hash);
+}
+
+
+auto	MStringInternTable::Find(MStringView str) const -> MStringId
+{
+	unsigned int	hash = hashOf(str);
+	Shard const&	shard = shards[hash & (ShardCount - 1)];
+
+	std::shared_lock<std::shared_timed_mutex> lock(shard.mutex);
+	return find(shard, str, hash);
+}
+
+
+auto	MStringInternTable::Resolve(MStringId id) const -> char const*
+{
+	if (!id.IsValid())
+		return "";
+	Shard const&	shard = shards[id.Value() & (ShardCount - 1)];
+	unsigned int	offset;
+	unsigned int	segment = locate(id.Value() >> ShardBits, offset);
+	return shard.segments[segment].load(std::memory_order_acquire)[offset];
+}
+
+
+auto	MStringInternTable::ResolveView(MStringId id) const -> MStringView
+{
+	if (!id.IsValid())
+		return MStringView();
+	char const*		str = Resolve(id);
+	unsigned int	length;
+	memcpy(&length, str - sizeof(unsigned int), sizeof(unsigned int));
+	return MStringView(str, length);
+}
+
+
+auto	MStringInternTable::GetStats() const -> Stats
+{
+	Stats stats;
+	for (Shard const& shard : shards)
+	{
+		std::shared_lock<std::shared_timed_mutex> lock(shard.mutex);
+		stats.Strings += shard.count;
+		stats.Requests += shard.requests.load(std::memory_order_relaxed);
+		stats.RequestedBytes += shard.requestedBytes.load(std::memory_order_relaxed);
+		stats.StoredBytes += shard.storedBytes;
+		stats.OverheadBytes += shard.slots.size() * sizeof(Slot) + shard.allocatedBytes - shard.storedBytes;
+		for (unsigned int segment = 0; segment < SegmentCount; ++segment)
+			if (shard.segments[segment].load(std::memory_order_relaxed))
+				stats.OverheadBytes += (PageSize << segment) * sizeof(char const*);
+	}
+	return stats;
+}
+
+
+auto	MStringInternTable::Global() -> MStringInternTable&
+{
+	static MStringInternTable table;
+	return table;
+}
+
+
+auto	MStringInternTable::find(Shard const& shard, MStringView str, unsigned int hash) const -> MStringId
+{
+	unsigned int mask = (unsigned int)shard.slots.size() - 1;
+	for (unsigned int idx = (hash >> ShardBits) & mask;; idx = (idx + 1) & mask)
+	{
+		Slot const& slot = shard.slots[idx];
+		if (slot.id == MStringId::Invalid)
+			return MStringId();
+		if (slot.hash == hash && ResolveView(MStringId(slot.id)) == str)
+			return MStringId(slot.id);
+	}
+}
+
+
+auto	MStringInternTable::insert(Shard& shard, MStringView str, unsigned int hash) -> MStringId
+{
+	unsigned int index = shard.count + 1;
+	assert(index <= MaxShardStrings && "MStringInternTable shard is full");
+	if (index > MaxShardStrings)
+		return MStringId();
+
+	if ((shard.count + 1) * 2 > shard.slots.size())
+		grow(shard);
+
+	//Segments are never moved, readers resolving older ids keep using them without a lock
+	unsigned int	offset;
+	unsigned int	segment = locate(index, offset);
+	char const**	strings = shard.segments[segment].load(std::memory_order_relaxed);
+	if (!strings)
+	{
+		strings = new char const*[PageSize << segment];
+		shard.segments[segment].store(strings, std::memory_order_release);
+	}
+	strings[offset] = store(shard, str);
+
+	MStringId		id((index << ShardBits) | (unsigned int)(&shard - shards));
+	unsigned int	mask = (unsigned int)shard.slots.size() - 1;
+	unsigned int	idx = (hash >> ShardBits) & mask;
+	while (shard.slots[idx].id != MStringId::Invalid)
+		idx = (idx + 1) & mask;
+	shard.slots[idx] = Slot{ hash, id.Value() };
+	++shard.count;
+	return id;
+}
+
+
+//Copies str in the shard blocks as [length][chars]['\0'] and returns a pointer to the chars
+auto	MStringInternTable::store(Shard& shard, MStringView str) -> char const*
+{
+	unsigned int	length = str.Count();
+	unsigned int	size = (sizeof(unsigned int) + length + 1 + sizeof(unsigned int) - 1) & ~(unsigned int)(sizeof(unsigned int) - 1);
+	char*			dest = nullptr;
+
+	if (size > BlockSize / 4)
+	{
+		//Long strings get their own block, inserted in front so the current block stays at the back
+		dest = new char[size];
+		shard.blocks.insert(shard.blocks.begin(), dest);
+		shard.allocatedBytes += size;
+	}
+	else
+	{
+		if (shard.blockUsed + size > BlockSize)
+		{
+			shard.blocks.push_back(new char[BlockSize]);
+			shard.blockUsed = 0;
+			shard.allocatedBytes += BlockSize;
+		}
+		dest = shard.blocks.back() + shard.blockUsed;
+		shard.blockUsed += size;
+	}
+
+	memcpy(dest, &length, sizeof(unsigned int));
+	memcpy(dest + sizeof(unsigned int), str.Data(), length);
+	dest[sizeof(unsigned int) + length] = '\0';
+	shard.storedBytes += size;
+	return dest + sizeof(unsigned int);
+}
+
+
+auto	MStringInternTable::grow(Shard& shard) -> void
+{
+	std::vector<Slot>	slots(shard.slots.size() * 2, Slot{ 0, MStringId::Invalid });
+	unsigned int		mask = (unsigned int)slots.size() - 1;
+	for (Slot const& slot : shard.slots)
+	{
+		if (slot.id == MStringId::Invalid)
+			continue;
+		unsigned int idx = (slot.hash >> ShardBits) & mask;
+		while (slots[idx].id != MStringId::Invalid)
+			idx = (idx + 1) & mask;
+		slots[idx] = slot;
+	}
+	shard.slots.swap(slots);
+}
+
+
+auto	MStringInternTable::locate(unsigned int index, unsigned int& offset) -> unsigned int
+{
+	unsigned int	shifted = index + PageSize;
+	unsigned int	bit = MStringSearch::HighestBit(shifted);
+	offset = shifted - (1u << bit);
+	return bit - PageBits;
+}
+
+
+//Folds the 64 bits MStringHash, low bits pick the shard
+auto	MStringInternTable::hashOf(MStringView str) -> unsigned int
+{
+	unsigned long long hash = str.Hash();
+	return (unsigned int)(hash ^ (hash >> 32));
+}
@@ -0,0 +1,124 @@
+#ifndef __MSTRINGINTERN_HPP__
+#define __MSTRINGINTERN_HPP__
+
+#include <atomic>
+#include <functional>
+#include <shared_mutex>
+#include <vector>
+
+#include "../String.hpp"
+
+//Handle on a string interned in a MStringInternTable, equal strings of a table share the same id
+class MStringId
+{
+public:
+	static const unsigned int	Invalid = 0;
+
+	MStringId() = default;
+	explicit MStringId(unsigned int value) : value(value) {}
+
+	//Interns into and resolves from MStringInternTable::Global()
+	static auto	Intern(MStringView str) -> MStringId;
+	auto	Str() const -> char const*;
+	auto	View() const -> MStringView;
+
+	auto	Value() const -> unsigned int { return value; }
+	auto	IsValid() const -> bool { return value != Invalid; }
+
+	bool	operator==(MStringId other) const { return value == other.value; }
+	bool	operator!=(MStringId other) const { return value != other.value; }
+	bool	operator<(MStringId other) const { return value < other.value; }
+
+private:
+	unsigned int	value = Invalid;
+};
+
+namespace std
+{
+	template<>
+	struct hash<MStringId>
+	{
+		size_t	operator()(MStringId id) const { return id.Value(); }
+	};
+}
+
+//Sharded string table, lookups of existing strings only take a shared lock on one shard
+//and resolving an id takes no lock at all. Interned strings live until the table is destroyed.
+class MStringInternTable
+{
+public:
+	struct Stats
+	{
+		unsigned int		Strings = 0;
+		unsigned long long	Requests = 0;
+		unsigned long long	RequestedBytes = 0;
+		unsigned long long	StoredBytes = 0;
+		unsigned long long	OverheadBytes = 0;
+	};
+
+	static const unsigned int	ShardBits = 4;
+	static const unsigned int	ShardCount = 1 << ShardBits;
+	static const unsigned int	MaxShardStrings = (1u << (32 - ShardBits)) - 1;
+
+	MStringInternTable();
+	MStringInternTable(MStringInternTable const&) = delete;
+	auto	operator=(MStringInternTable const&) -> MStringInternTable& = delete;
+	~MStringInternTable();
+
+	//A shard holds up to MaxShardStrings strings, the ids have no room for more. Past that Intern asserts
+	//and returns an invalid id.
+	auto	Intern(MStringView str) -> MStringId;
+	//Returns an invalid id when str was never interned
+	auto	Find(MStringView str) const -> MStringId;
+
+	auto	Resolve(MStringId id) const -> char const*;
+	auto	ResolveView(MStringId id) const -> MStringView;
+
+	auto	GetStats() const -> Stats;
+
+	static auto	Global() -> MStringInternTable&;
+
+private:
+	//Segment n holds PageSize << n string pointers, enough segments to reach MaxShardStrings
+	static const unsigned int	PageBits = 12;
+	static const unsigned int	PageSize = 1 << PageBits;
+	static const unsigned int	SegmentCount = 32 - ShardBits - PageBits + 1;
+	static const unsigned int	BlockSize = 64 * 1024;
+
+	struct Slot
+	{
+		unsigned int	hash;
+		unsigned int	id;
+	};
+
+	struct alignas(64) Shard
+	{
+		mutable std::shared_timed_mutex			mutex;
+		std::vector<Slot>						slots;
+		unsigned int							count = 0;
+		std::atomic<char const**>				segments[SegmentCount];
+		std::vector<char*>						blocks;
+		unsigned int							blockUsed = BlockSize;
+		unsigned long long						storedBytes = 0;
+		unsigned long long						allocatedBytes = 0;
+		mutable std::atomic<unsigned long long>	requests;
+		mutable std::atomic<unsigned long long>	requestedBytes;
+	};
+
+	auto	find(Shard const& shard, MStringView str, unsigned int hash) const -> MStringId;
+	auto	insert(Shard& shard, MStringView str, unsigned int hash) -> MStringId;
+	auto	store(Shard& shard, MStringView str) -> char const*;
+	auto	grow(Shard& shard) -> void;
+
+	static auto	hashOf(MStringView str) -> unsigned int;
+	//Segment of the string at index, offset receives its position in the segment
+	static auto	locate(unsigned int index, unsigned int& offset) -> unsigned int;
+
+	Shard	shards[ShardCount];
+};
+
+inline auto	MStringId::Intern(MStringView str) -> MStringId { return MStringInternTable::Global().Intern(str); }
+inline auto	MStringId::Str() const -> char const* { return MStringInternTable::Global().Resolve(*this); }
+inline auto	MStringId::View() const -> MStringView { return MStringInternTable::Global().ResolveView(*this); }
+
+#endif /*__MSTRINGINTERN_HPP__*/
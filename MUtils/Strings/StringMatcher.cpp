@@ -0,0 +1,141 @@
+#include "StringMatcher.hpp"
+
+auto	MStringMatcher::AddPattern(MStringView pattern) -> unsigned int
+{
+	patterns.push_back(Pattern{ (unsigned int)patternData.size(), pattern.Count() });
+	patternData.insert(patternData.end(), pattern.begin(), pattern.end());
+	return (unsigned int)patterns.size() - 1;
+}
+
+auto	MStringMatcher::Build() -> void
+{
+	bool			used[256] = {};
+	unsigned int	usedCount = 0;
+	for (char c : patternData)
+	{
+		usedCount += !used[(unsigned char)c];
+		used[(unsigned char)c] = true;
+	}
+	//Class 0 is only reserved for unused bytes when there are some, so the class always fits a byte
+	classCount = usedCount < 256 ? 1 : 0;
+	for (unsigned int idx = 0; idx < 256; ++idx)
+		classes[idx] = used[idx] ? (unsigned char)classCount++ : 0;
+
+	//Trie with dense children, 0 meaning no child since the root is never one
+	std::vector<unsigned int>				trie(classCount, 0);
+	std::vector<std::vector<unsigned int>>	nodeOutputs(1);
+	for (unsigned int id = 0; id < patterns.size(); ++id)
+	{
+		if (patterns[id].length == 0)
+			continue;
+		unsigned int node = 0;
+		for (unsigned int idx = 0; idx < patterns[id].length; ++idx)
+		{
+			unsigned int slot = node * classCount + classes[(unsigned char)patternData[patterns[id].offset + idx]];
+			if (trie[slot] == 0)
+			{
+				trie[slot] = (unsigned int)nodeOutputs.size();
+				trie.resize(trie.size() + classCount, 0);
+				nodeOutputs.emplace_back();
+			}
+			node = trie[slot];
+		}
+		nodeOutputs[node].push_back(id);
+	}
+
+	//Breadth first, failure links and missing transitions only depend on shallower nodes
+	unsigned int				nodeCount = (unsigned int)nodeOutputs.size();
+	std::vector<unsigned int>	fail(nodeCount, 0);
+	std::vector<unsigned int>	order;
+	order.reserve(nodeCount);
+	order.push_back(0);
+	for (unsigned int head = 0; head < order.size(); ++head)
+	{
+		unsigned int node = order[head];
+		for (unsigned int cls = 0; cls < classCount; ++cls)
+		{
+			unsigned int&	next = trie[node * classCount + cls];
+			unsigned int	fallback = node == 0 ? 0 : trie[fail[node] * classCount + cls];
+			if (next == 0)
+			{
+				next = fallback;
+				continue;
+			}
+			fail[next] = fallback;
+			std::vector<unsigned int> const& inherited = nodeOutputs[fallback];
+			nodeOutputs[next].insert(nodeOutputs[next].end(), inherited.begin(), inherited.end());
+			order.push_back(next);
+		}
+	}
+
+	//States without output first so a single compare spots matches, breadth first order keeps the hot shallow states together
+	std::vector<unsigned int>	renumber(nodeCount);
+	unsigned int				nextId = 0;
+	for (unsigned int node : order)
+	{
+		if (nodeOutputs[node].empty())
+			renumber[node] = nextId++;
+	}
+	firstMatch = nextId * classCount;
+	outputBegin.assign(1, 0);
+	outputs.clear();
+	for (unsigned int node : order)
+	{
+		if (nodeOutputs[node].empty())
+			continue;
+		renumber[node] = nextId++;
+		outputs.insert(outputs.end(), nodeOutputs[node].begin(), nodeOutputs[node].end());
+		outputBegin.push_back((unsigned int)outputs.size());
+	}
+
+	transitions.assign(nodeCount * classCount, 0);
+	for (unsigned int node = 0; node < nodeCount; ++node)
+	{
+		unsigned int const*	from = trie.data() + node * classCount;
+		unsigned int*		to = transitions.data() + renumber[node] * classCount;
+		for (unsigned int cls = 0; cls < classCount; ++cls)
+			to[cls] = renumber[from[cls]] * classCount;
+	}
+
+	bool			first[256] = {};
+	unsigned int	firstCount = 0;
+	for (Pattern const& pattern : patterns)
+	{
+		if (pattern.length == 0)
+			continue;
+		unsigned char c = (unsigned char)patternData[pattern.offset];
+		firstCount += !first[c];
+		first[c] = true;
+	}
+	prefilterCount = 0;
+	if (firstCount <= MaxPrefilterBytes)
+	{
+		for (unsigned int idx = 0; idx < 256; ++idx)
+		{
+			if (first[idx])
+				prefilter[prefilterCount++] = (char)idx;
+		}
+	}
+}
+
+auto	MStringMatcher::FindAll(MStringView text, std::vector<Match>& matches) const -> unsigned int
+{
+	size_t before = matches.size();
+	Scan(text, [&matches](Match const& match)
+	{
+		matches.push_back(match);
+		return true;
+	});
+	return (unsigned int)(matches.size() - before);
+}
+
+auto	MStringMatcher::ContainsAny(MStringView text) const -> bool
+{
+	bool found = false;
+	Scan(text, [&found](Match const&)
+	{
+		found = true;
+		return false;
+	});
+	return found;
+}
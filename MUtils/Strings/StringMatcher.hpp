@@ -0,0 +1,94 @@
+#ifndef __MSTRINGMATCHER_HPP__
+#define __MSTRINGMATCHER_HPP__
+
+#include <vector>
+
+#include "../String.hpp"
+
+//Aho-Corasick automaton finding every occurrence of many patterns in one pass over the text.
+//Add the patterns, call Build once, then scans are const and can run from several threads.
+class MStringMatcher
+{
+public:
+	struct Match
+	{
+		unsigned int	Pattern;
+		unsigned int	Offset;
+	};
+
+	//Above this many distinct first bytes the prefilter is not worth it
+	static const unsigned int	MaxPrefilterBytes = 4;
+
+	//Returns the pattern id, ids are given in order from 0. An empty pattern never matches.
+	//Patterns added after Build are only searched once Build is called again.
+	auto	AddPattern(MStringView pattern) -> unsigned int;
+	auto	Build() -> void;
+
+	auto	PatternCount() const -> unsigned int { return (unsigned int)patterns.size(); }
+	auto	StateCount() const -> unsigned int { return classCount ? (unsigned int)(transitions.size() / classCount) : 0; }
+	auto	IsBuilt() const -> bool { return !transitions.empty(); }
+
+	//Calls callback(Match) for every occurrence, overlapping ones included, in order of their end.
+	//The scan stops early when callback returns false.
+	template<class Callback>
+	auto	Scan(MStringView text, Callback&& callback) const -> void;
+
+	//Appends every occurrence to matches, returns how many were found
+	auto	FindAll(MStringView text, std::vector<Match>& matches) const -> unsigned int;
+	auto	ContainsAny(MStringView text) const -> bool;
+
+private:
+	struct Pattern
+	{
+		unsigned int	offset;
+		unsigned int	length;
+	};
+
+	std::vector<char>			patternData;
+	std::vector<Pattern>		patterns;
+
+	//Bytes used by no pattern share class 0, transitions are indexed by state * classCount + class and hold
+	//the next state already multiplied by classCount. States from firstMatch on have outputs.
+	unsigned char				classes[256] = {};
+	unsigned int				classCount = 0;
+	std::vector<unsigned int>	transitions;
+	unsigned int				firstMatch = 0;
+	//Match state n (counted from firstMatch) reports outputs[outputBegin[n]] up to outputs[outputBegin[n + 1]]
+	std::vector<unsigned int>	outputBegin;
+	std::vector<unsigned int>	outputs;
+	char						prefilter[MaxPrefilterBytes] = {};
+	unsigned int				prefilterCount = 0;
+};
+
+template<class Callback>
+auto	MStringMatcher::Scan(MStringView text, Callback&& callback) const -> void
+{
+	if (transitions.empty())
+		return;
+	char const*			data = text.Data();
+	unsigned int		count = text.Count();
+	unsigned int const*	table = transitions.data();
+	unsigned int		state = 0;
+	for (unsigned int pos = 0; pos < count; ++pos)
+	{
+		//From the root only a first byte can start a match, the others are skipped with SIMD
+		if (state == 0 && prefilterCount != 0)
+		{
+			pos = MStringSearch::FindAny(data, count, prefilter, prefilterCount, pos);
+			if (pos == MStringSearch::NotFound)
+				return;
+		}
+		state = table[state + classes[(unsigned char)data[pos]]];
+		if (state < firstMatch)
+			continue;
+		unsigned int matchState = (state - firstMatch) / classCount;
+		for (unsigned int idx = outputBegin[matchState]; idx < outputBegin[matchState + 1]; ++idx)
+		{
+			unsigned int pattern = outputs[idx];
+			if (!callback(Match{ pattern, pos + 1 - patterns[pattern].length }))
+				return;
+		}
+	}
+}
+
+#endif /*__MSTRINGMATCHER_HPP__*/
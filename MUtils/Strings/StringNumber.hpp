@@ -0,0 +1,683 @@
+#ifndef __MSTRINGNUMBER_HPP__
+#define __MSTRINGNUMBER_HPP__
+
+#include <cstring>
+
+//Locale free number <-> text conversions writing straight into caller buffers.
+//Formatting never writes a terminator, parsing returns the number of chars consumed, 0 meaning failure.
+class MStringNumber
+{
+public:
+	static const unsigned int	MaxIntChars = 20;
+	static const unsigned int	MaxFloatChars = 16;
+
+	static auto	FormatUInt(char* buffer, unsigned long long value) -> unsigned int
+	{
+		unsigned int length = decimalLength(value);
+		writeDigits(buffer, length, value);
+		return length;
+	}
+
+	static auto	FormatInt(char* buffer, long long value) -> unsigned int
+	{
+		if (value >= 0)
+			return FormatUInt(buffer, (unsigned long long)value);
+		*buffer = '-';
+		return 1 + FormatUInt(buffer + 1, 0ull - (unsigned long long)value);
+	}
+
+	//Exact number of chars FormatUInt / FormatInt write
+	static auto	UIntLength(unsigned long long value) -> unsigned int { return decimalLength(value); }
+	static auto	IntLength(long long value) -> unsigned int { return value >= 0 ? decimalLength((unsigned long long)value) : 1 + decimalLength(0ull - (unsigned long long)value); }
+
+	//Shortest text that parses back to the same float (Ryu), in fixed or scientific notation whichever is shorter
+	static auto	FormatFloat(char* buffer, float value) -> unsigned int
+	{
+		unsigned int bits;
+		memcpy(&bits, &value, sizeof(float));
+		unsigned int	ieeeMantissa = bits & ((1u << 23) - 1);
+		unsigned int	ieeeExponent = (bits >> 23) & 0xFF;
+		char*			out = buffer;
+
+		if (ieeeExponent == 0xFF && ieeeMantissa != 0)
+			return copyWord(out, "nan");
+		if (bits >> 31)
+			*out++ = '-';
+		if (ieeeExponent == 0xFF)
+			return (unsigned int)(out - buffer) + copyWord(out, "inf");
+		if (ieeeExponent == 0 && ieeeMantissa == 0)
+		{
+			*out++ = '0';
+			return (unsigned int)(out - buffer);
+		}
+
+		int				exponent;
+		unsigned int	digits = shortestDecimal(ieeeMantissa, ieeeExponent, exponent);
+		unsigned int	length = decimalLength(digits);
+		int				sciExponent = exponent + (int)length - 1;
+		unsigned int	sciLength = length + (length > 1 ? 1 : 0) + 2 + (sciExponent >= 100 || sciExponent <= -100 ? 3 : 2);
+		unsigned int	fixedLength;
+		if (exponent >= 0)
+			fixedLength = length + exponent;
+		else if ((int)length + exponent > 0)
+			fixedLength = length + 1;
+		else
+			fixedLength = 2 + (unsigned int)-exponent;
+
+		if (fixedLength <= sciLength)
+		{
+			if (exponent >= 0)
+			{
+				writeDigits(out, length, digits);
+				memset(out + length, '0', exponent);
+			}
+			else if ((int)length + exponent > 0)
+			{
+				unsigned int integral = length - (unsigned int)-exponent;
+				writeDigits(out + 1, length, digits);
+				memmove(out, out + 1, integral);
+				out[integral] = '.';
+			}
+			else
+			{
+				out[0] = '0';
+				out[1] = '.';
+				memset(out + 2, '0', -exponent - length);
+				writeDigits(out + fixedLength - length, length, digits);
+			}
+			return (unsigned int)(out - buffer) + fixedLength;
+		}
+
+		writeDigits(out + 1, length, digits);
+		out[0] = out[1];
+		if (length > 1)
+		{
+			out[1] = '.';
+			out += length + 1;
+		}
+		else
+			out += 1;
+		*out++ = 'e';
+		*out++ = sciExponent < 0 ? '-' : '+';
+		unsigned int absExponent = sciExponent < 0 ? -sciExponent : sciExponent;
+		out += writeDigits(out, absExponent >= 100 ? 3 : 2, absExponent);
+		return (unsigned int)(out - buffer);
+	}
+
+	static auto	ParseUInt(char const* str, unsigned int count, unsigned long long& value, unsigned long long max = ~0ull) -> unsigned int
+	{
+		unsigned int		pos = 0;
+		unsigned long long	res = 0;
+		if (pos < count && str[pos] == '+')
+			++pos;
+		unsigned int start = pos;
+		for (; pos < count && isDigit(str[pos]); ++pos)
+		{
+			unsigned int digit = str[pos] - '0';
+			if (res > (max - digit) / 10)
+				return 0;
+			res = res * 10 + digit;
+		}
+		if (pos == start)
+			return 0;
+		value = res;
+		return pos;
+	}
+
+	static auto	ParseUInt(char const* str, unsigned int count, unsigned int& value) -> unsigned int
+	{
+		unsigned long long	res;
+		unsigned int		consumed = ParseUInt(str, count, res, 0xFFFFFFFFull);
+		if (consumed)
+			value = (unsigned int)res;
+		return consumed;
+	}
+
+	static auto	ParseInt(char const* str, unsigned int count, long long& value) -> unsigned int
+	{
+		unsigned long long	magnitude;
+		if (count > 0 && str[0] == '-')
+		{
+			if (count > 1 && str[1] == '+')
+				return 0;
+			unsigned int consumed = ParseUInt(str + 1, count - 1, magnitude, 0x8000000000000000ull);
+			if (!consumed)
+				return 0;
+			value = (long long)(0ull - magnitude);
+			return consumed + 1;
+		}
+		unsigned int consumed = ParseUInt(str, count, magnitude, 0x7FFFFFFFFFFFFFFFull);
+		if (consumed)
+			value = (long long)magnitude;
+		return consumed;
+	}
+
+	static auto	ParseInt(char const* str, unsigned int count, int& value) -> unsigned int
+	{
+		long long		res;
+		unsigned int	consumed = ParseInt(str, count, res);
+		if (!consumed || res < -2147483647ll - 1 || res > 2147483647ll)
+			return 0;
+		value = (int)res;
+		return consumed;
+	}
+
+	//Accepts [+-]digits[.digits][(e|E)[+-]digits], inf, infinity and nan, the result is correctly rounded
+	static auto	ParseFloat(char const* str, unsigned int count, float& value) -> unsigned int
+	{
+		unsigned int	pos = 0;
+		bool			negative = false;
+		if (pos < count && (str[pos] == '-' || str[pos] == '+'))
+			negative = str[pos++] == '-';
+
+		unsigned int special = matchWord(str + pos, count - pos, "infinity");
+		if (!special)
+			special = matchWord(str + pos, count - pos, "inf");
+		if (special)
+		{
+			unsigned int infBits = negative ? 0xFF800000u : 0x7F800000u;
+			memcpy(&value, &infBits, sizeof(float));
+			return pos + special;
+		}
+		special = matchWord(str + pos, count - pos, "nan");
+		if (special)
+		{
+			unsigned int nanBits = 0x7FC00000u;
+			memcpy(&value, &nanBits, sizeof(float));
+			return pos + special;
+		}
+
+		unsigned int	digitsBegin = pos;
+		bool			anyDigit = false;
+		for (; pos < count && isDigit(str[pos]); ++pos)
+			anyDigit = true;
+		if (pos < count && str[pos] == '.' && (anyDigit || (pos + 1 < count && isDigit(str[pos + 1]))))
+		{
+			for (++pos; pos < count && isDigit(str[pos]); ++pos)
+				anyDigit = true;
+		}
+		if (!anyDigit)
+			return 0;
+		unsigned int	digitsEnd = pos;
+
+		int exponent = 0;
+		if (pos < count && (str[pos] == 'e' || str[pos] == 'E'))
+		{
+			unsigned int	expPos = pos + 1;
+			bool			expNegative = false;
+			if (expPos < count && (str[expPos] == '-' || str[expPos] == '+'))
+				expNegative = str[expPos++] == '-';
+			if (expPos < count && isDigit(str[expPos]))
+			{
+				for (; expPos < count && isDigit(str[expPos]); ++expPos)
+				{
+					if (exponent < 100000)
+						exponent = exponent * 10 + (str[expPos] - '0');
+				}
+				if (expNegative)
+					exponent = -exponent;
+				pos = expPos;
+			}
+		}
+
+		value = toFloat(str + digitsBegin, digitsEnd - digitsBegin, exponent);
+		if (negative)
+			value = -value;
+		return pos;
+	}
+
+private:
+	static auto	isDigit(char c) -> bool { return (unsigned char)(c - '0') < 10; }
+
+	static auto	copyWord(char* out, char const* word) -> unsigned int
+	{
+		unsigned int length = (unsigned int)strlen(word);
+		memcpy(out, word, length);
+		return length;
+	}
+
+	//ASCII case insensitive match of the whole word at the start of str
+	static auto	matchWord(char const* str, unsigned int count, char const* word) -> unsigned int
+	{
+		unsigned int length = (unsigned int)strlen(word);
+		if (count < length)
+			return 0;
+		for (unsigned int idx = 0; idx < length; ++idx)
+		{
+			if ((str[idx] | 0x20) != word[idx])
+				return 0;
+		}
+		return length;
+	}
+
+	static auto	decimalLength(unsigned long long value) -> unsigned int
+	{
+		unsigned int length = 1;
+		for (; value >= 10000; value /= 10000)
+			length += 4;
+		if (value >= 1000)
+			return length + 3;
+		if (value >= 100)
+			return length + 2;
+		return length + (value >= 10 ? 1 : 0);
+	}
+
+	//Writes the length last digits of value, two at a time from the end
+	static auto	writeDigits(char* out, unsigned int length, unsigned long long value) -> unsigned int
+	{
+		static const char pairs[] =
+			"0001020304050607080910111213141516171819202122232425262728293031323334353637383940414243444546474849"
+			"5051525354555657585960616263646566676869707172737475767778798081828384858687888990919293949596979899";
+		char* it = out + length;
+		while (it - out >= 2)
+		{
+			unsigned int pair = (unsigned int)(value % 100) * 2;
+			value /= 100;
+			*--it = pairs[pair + 1];
+			*--it = pairs[pair];
+		}
+		if (it != out)
+			*--it = (char)('0' + value % 10);
+		return length;
+	}
+
+	static auto	pow5Bits(int e) -> int { return (int)(((unsigned int)e * 1217359) >> 19) + 1; }
+	static auto	log10Pow2(int e) -> unsigned int { return ((unsigned int)e * 78913) >> 18; }
+	static auto	log10Pow5(int e) -> unsigned int { return ((unsigned int)e * 732923) >> 20; }
+
+	static auto	pow5Factor(unsigned int value) -> unsigned int
+	{
+		unsigned int count = 0;
+		for (; value % 5 == 0; value /= 5)
+			++count;
+		return count;
+	}
+
+	static auto	mulShift(unsigned int m, unsigned long long factor, int shift) -> unsigned int
+	{
+		unsigned long long	low = (unsigned long long)m * (unsigned int)factor;
+		unsigned long long	high = (unsigned long long)m * (unsigned int)(factor >> 32);
+		return (unsigned int)(((low >> 32) + high) >> (shift - 32));
+	}
+
+	//floor(2^(pow5Bits(i) - 1 + 59) / 5^i) + 1
+	static auto	mulPow5InvDivPow2(unsigned int m, unsigned int i, int shift) -> unsigned int
+	{
+		static const unsigned long long table[31] =
+		{
+			576460752303423489u, 461168601842738791u, 368934881474191033u, 295147905179352826u, 472236648286964522u, 377789318629571618u,
+			302231454903657294u, 483570327845851670u, 386856262276681336u, 309485009821345069u, 495176015714152110u, 396140812571321688u,
+			316912650057057351u, 507060240091291761u, 405648192073033409u, 324518553658426727u, 519229685853482763u, 415383748682786211u,
+			332306998946228969u, 531691198313966350u, 425352958651173080u, 340282366920938464u, 544451787073501542u, 435561429658801234u,
+			348449143727040987u, 557518629963265579u, 446014903970612463u, 356811923176489971u, 570899077082383953u, 456719261665907162u,
+			365375409332725730u
+		};
+		return mulShift(m, table[i], shift);
+	}
+
+	//5^i normalized to 61 bits
+	static auto	mulPow5DivPow2(unsigned int m, unsigned int i, int shift) -> unsigned int
+	{
+		static const unsigned long long table[47] =
+		{
+			1152921504606846976u, 1441151880758558720u, 1801439850948198400u, 2251799813685248000u, 1407374883553280000u,
+			1759218604441600000u, 2199023255552000000u, 1374389534720000000u, 1717986918400000000u, 2147483648000000000u,
+			1342177280000000000u, 1677721600000000000u, 2097152000000000000u, 1310720000000000000u, 1638400000000000000u,
+			2048000000000000000u, 1280000000000000000u, 1600000000000000000u, 2000000000000000000u, 1250000000000000000u,
+			1562500000000000000u, 1953125000000000000u, 1220703125000000000u, 1525878906250000000u, 1907348632812500000u,
+			1192092895507812500u, 1490116119384765625u, 1862645149230957031u, 1164153218269348144u, 1455191522836685180u,
+			1818989403545856475u, 2273736754432320594u, 1421085471520200371u, 1776356839400250464u, 2220446049250313080u,
+			1387778780781445675u, 1734723475976807094u, 2168404344971008868u, 1355252715606880542u, 1694065894508600678u,
+			2117582368135750847u, 1323488980084844279u, 1654361225106055349u, 2067951531382569187u, 1292469707114105741u,
+			1615587133892632177u, 2019483917365790221u
+		};
+		return mulShift(m, table[i], shift);
+	}
+
+	//Ryu f2s: shortest digits * 10^exponent inside the rounding interval of the float
+	static auto	shortestDecimal(unsigned int ieeeMantissa, unsigned int ieeeExponent, int& exponent) -> unsigned int
+	{
+		int				e2;
+		unsigned int	m2;
+		if (ieeeExponent == 0)
+		{
+			e2 = 1 - 127 - 23 - 2;
+			m2 = ieeeMantissa;
+		}
+		else
+		{
+			e2 = (int)ieeeExponent - 127 - 23 - 2;
+			m2 = (1u << 23) | ieeeMantissa;
+		}
+		bool			acceptBounds = (m2 & 1) == 0;
+		unsigned int	mv = 4 * m2;
+		unsigned int	mp = 4 * m2 + 2;
+		unsigned int	mmShift = ieeeMantissa != 0 || ieeeExponent <= 1;
+		unsigned int	mm = 4 * m2 - 1 - mmShift;
+
+		unsigned int	vr, vp, vm;
+		int				e10;
+		bool			vmIsTrailingZeros = false;
+		bool			vrIsTrailingZeros = false;
+		unsigned int	lastRemovedDigit = 0;
+		if (e2 >= 0)
+		{
+			unsigned int	q = log10Pow2(e2);
+			int				k = 59 + pow5Bits(q) - 1;
+			int				i = -e2 + (int)q + k;
+			e10 = (int)q;
+			vr = mulPow5InvDivPow2(mv, q, i);
+			vp = mulPow5InvDivPow2(mp, q, i);
+			vm = mulPow5InvDivPow2(mm, q, i);
+			if (q != 0 && (vp - 1) / 10 <= vm / 10)
+			{
+				int l = 59 + pow5Bits(q - 1) - 1;
+				lastRemovedDigit = mulPow5InvDivPow2(mv, q - 1, -e2 + (int)q - 1 + l) % 10;
+			}
+			if (q <= 9)
+			{
+				if (mv % 5 == 0)
+					vrIsTrailingZeros = pow5Factor(mv) >= q;
+				else if (acceptBounds)
+					vmIsTrailingZeros = pow5Factor(mm) >= q;
+				else
+					vp -= pow5Factor(mp) >= q;
+			}
+		}
+		else
+		{
+			unsigned int	q = log10Pow5(-e2);
+			int				i = -e2 - (int)q;
+			int				k = pow5Bits(i) - 61;
+			int				j = (int)q - k;
+			e10 = (int)q + e2;
+			vr = mulPow5DivPow2(mv, i, j);
+			vp = mulPow5DivPow2(mp, i, j);
+			vm = mulPow5DivPow2(mm, i, j);
+			if (q != 0 && (vp - 1) / 10 <= vm / 10)
+			{
+				j = (int)q - 1 - (pow5Bits(i + 1) - 61);
+				lastRemovedDigit = mulPow5DivPow2(mv, i + 1, j) % 10;
+			}
+			if (q <= 1)
+			{
+				vrIsTrailingZeros = true;
+				if (acceptBounds)
+					vmIsTrailingZeros = mmShift == 1;
+				else
+					--vp;
+			}
+			else if (q < 31)
+				vrIsTrailingZeros = (mv & ((1u << (q - 1)) - 1)) == 0;
+		}
+
+		int				removed = 0;
+		unsigned int	output;
+		if (vmIsTrailingZeros || vrIsTrailingZeros)
+		{
+			for (; vp / 10 > vm / 10; ++removed)
+			{
+				vmIsTrailingZeros &= vm % 10 == 0;
+				vrIsTrailingZeros &= lastRemovedDigit == 0;
+				lastRemovedDigit = vr % 10;
+				vr /= 10;
+				vp /= 10;
+				vm /= 10;
+			}
+			if (vmIsTrailingZeros)
+			{
+				for (; vm % 10 == 0; ++removed)
+				{
+					vrIsTrailingZeros &= lastRemovedDigit == 0;
+					lastRemovedDigit = vr % 10;
+					vr /= 10;
+					vp /= 10;
+					vm /= 10;
+				}
+			}
+			if (vrIsTrailingZeros && lastRemovedDigit == 5 && vr % 2 == 0)
+				lastRemovedDigit = 4;
+			output = vr + ((vr == vm && (!acceptBounds || !vmIsTrailingZeros)) || lastRemovedDigit >= 5);
+		}
+		else
+		{
+			for (; vp / 10 > vm / 10; ++removed)
+			{
+				lastRemovedDigit = vr % 10;
+				vr /= 10;
+				vp /= 10;
+				vm /= 10;
+			}
+			output = vr + (vr == vm || lastRemovedDigit >= 5);
+		}
+		exponent = e10 + removed;
+		return output;
+	}
+
+	//Fixed size unsigned integer, large enough for the exact comparisons of toFloat
+	struct BigInt
+	{
+		static const unsigned int	MaxLimbs = 28;
+
+		unsigned int	limbs[MaxLimbs];
+		unsigned int	size;
+
+		BigInt(unsigned long long value) : size(0)
+		{
+			for (; value != 0; value >>= 32)
+				limbs[size++] = (unsigned int)value;
+		}
+
+		auto	MulSmall(unsigned int factor) -> void
+		{
+			unsigned long long carry = 0;
+			for (unsigned int idx = 0; idx < size; ++idx)
+			{
+				carry += (unsigned long long)limbs[idx] * factor;
+				limbs[idx] = (unsigned int)carry;
+				carry >>= 32;
+			}
+			if (carry)
+				limbs[size++] = (unsigned int)carry;
+		}
+
+		auto	AddSmall(unsigned int value) -> void
+		{
+			for (unsigned int idx = 0; value != 0; ++idx)
+			{
+				if (idx == size)
+					limbs[size++] = 0;
+				unsigned long long sum = (unsigned long long)limbs[idx] + value;
+				limbs[idx] = (unsigned int)sum;
+				value = (unsigned int)(sum >> 32);
+			}
+		}
+
+		auto	IsZero() const -> bool { return size == 0; }
+
+		auto	MulPow5(unsigned int power) -> void
+		{
+			for (; power >= 13; power -= 13)
+				MulSmall(1220703125u);
+			unsigned int factor = 1;
+			for (; power > 0; --power)
+				factor *= 5;
+			MulSmall(factor);
+		}
+
+		auto	ShiftLeft(unsigned int bits) -> void
+		{
+			if (size == 0)
+				return;
+			unsigned int words = bits / 32;
+			bits %= 32;
+			limbs[size] = 0;
+			if (bits)
+			{
+				for (unsigned int idx = size; idx > 0; --idx)
+					limbs[idx] = (limbs[idx] << bits) | (limbs[idx - 1] >> (32 - bits));
+				limbs[0] <<= bits;
+				size += limbs[size] != 0;
+			}
+			if (words)
+			{
+				memmove(limbs + words, limbs, size * sizeof(unsigned int));
+				memset(limbs, 0, words * sizeof(unsigned int));
+				size += words;
+			}
+		}
+
+		static auto	Compare(BigInt const& first, BigInt const& second) -> int
+		{
+			if (first.size != second.size)
+				return first.size < second.size ? -1 : 1;
+			for (unsigned int idx = first.size; idx > 0; --idx)
+			{
+				if (first.limbs[idx - 1] != second.limbs[idx - 1])
+					return first.limbs[idx - 1] < second.limbs[idx - 1] ? -1 : 1;
+			}
+			return 0;
+		}
+	};
+
+	static auto	mulAdd(unsigned long long& value, unsigned int digit) -> void { value = value * 10 + digit; }
+	static auto	mulAdd(BigInt& value, unsigned int digit) -> void
+	{
+		value.MulSmall(10);
+		value.AddSmall(digit);
+	}
+
+	static auto	isZero(unsigned long long value) -> bool { return value == 0; }
+	static auto	isZero(BigInt const& value) -> bool { return value.IsZero(); }
+
+	//Reads the first maxDigits significant digits of [digits][.digits] into value, adjusting exponent so that
+	//the text equals value * 10^exponent. Returns true when non zero digits were dropped.
+	template<class Integer>
+	static auto	readDigits(char const* text, unsigned int count, unsigned int maxDigits, Integer& value, int& exponent) -> bool
+	{
+		bool			truncated = false;
+		bool			fraction = false;
+		unsigned int	stored = 0;
+		for (unsigned int idx = 0; idx < count; ++idx)
+		{
+			if (text[idx] == '.')
+			{
+				fraction = true;
+				continue;
+			}
+			unsigned int digit = text[idx] - '0';
+			if (stored < maxDigits)
+			{
+				mulAdd(value, digit);
+				stored += !isZero(value);
+				exponent -= fraction;
+			}
+			else
+			{
+				exponent += !fraction;
+				truncated |= digit != 0;
+			}
+		}
+		return truncated;
+	}
+
+	//Sign of value * 10^exponent - half * 2^halfExponent
+	static auto	compareExact(BigInt left, int exponent, unsigned int half, int halfExponent) -> int
+	{
+		BigInt	right(half);
+		if (exponent >= 0)
+			left.MulPow5((unsigned int)exponent);
+		else
+			right.MulPow5((unsigned int)-exponent);
+		if (exponent > halfExponent)
+			left.ShiftLeft((unsigned int)(exponent - halfExponent));
+		else
+			right.ShiftLeft((unsigned int)(halfExponent - exponent));
+		return BigInt::Compare(left, right);
+	}
+
+	static auto	toFloat(char const* digits, unsigned int count, int exponent) -> float
+	{
+		static const float	floatPowers[] = { 1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f };
+		static const double	doublePowers[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+			1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+
+		unsigned long long	mantissa = 0;
+		int					mantissaExponent = exponent;
+		bool				truncated = readDigits(digits, count, 19, mantissa, mantissaExponent);
+		if (mantissa == 0)
+			return 0.0f;
+		//Both operands are exact so the single rounding of the operation is the correct one
+		if (!truncated && mantissa <= (1u << 24) && mantissaExponent >= -10 && mantissaExponent <= 10)
+			return mantissaExponent < 0 ? (float)mantissa / floatPowers[-mantissaExponent] : (float)mantissa * floatPowers[mantissaExponent];
+
+		int length = (int)decimalLength(mantissa);
+		if (mantissaExponent + length > 40)
+			return fromBits(0x7F800000u);
+		if (mantissaExponent + length < -46)
+			return 0.0f;
+
+		double	estimate = (double)mantissa;
+		int		power = mantissaExponent;
+		for (; power > 22; power -= 22)
+			estimate *= doublePowers[22];
+		for (; power < -22; power += 22)
+			estimate /= doublePowers[22];
+		estimate = power < 0 ? estimate / doublePowers[-power] : estimate * doublePowers[power];
+
+		//Float midpoints have less than 120 significant digits, so the first 120 digits plus a sticky
+		//flag for the dropped ones are enough to place the text exactly against them
+		BigInt	exact(mantissa);
+		int		exactExponent = mantissaExponent;
+		bool	sticky = false;
+		if (truncated)
+		{
+			exact = BigInt(0);
+			exactExponent = exponent;
+			sticky = readDigits(digits, count, 120, exact, exactExponent);
+		}
+
+		//The estimate is at most one float away, fix it with exact comparisons against the rounding midpoints
+		float			candidate = (float)estimate;
+		unsigned int	bits;
+		memcpy(&bits, &candidate, sizeof(float));
+		for (;;)
+		{
+			unsigned int	ieeeMantissa = bits & ((1u << 23) - 1);
+			unsigned int	ieeeExponent = bits >> 23;
+			unsigned int	m = ieeeExponent ? (1u << 23) | ieeeMantissa : ieeeMantissa;
+			int				e = (ieeeExponent ? (int)ieeeExponent : 1) - 150;
+			bool			odd = (bits & 1) != 0;
+
+			if (bits < 0x7F800000u)
+			{
+				int res = compareExact(exact, exactExponent, 2 * m + 1, e - 1);
+				if (res > 0 || (res == 0 && (sticky || odd)))
+				{
+					++bits;
+					continue;
+				}
+			}
+			if (bits > 0)
+			{
+				bool	binadeStart = ieeeMantissa == 0 && ieeeExponent > 1;
+				int		res = binadeStart ? compareExact(exact, exactExponent, 4 * m - 1, e - 2) : compareExact(exact, exactExponent, 2 * m - 1, e - 1);
+				if (res < 0 || (res == 0 && !sticky && odd))
+				{
+					--bits;
+					continue;
+				}
+			}
+			return fromBits(bits);
+		}
+	}
+
+	static auto	fromBits(unsigned int bits) -> float
+	{
+		float value;
+		memcpy(&value, &bits, sizeof(float));
+		return value;
+	}
+};
+
+#endif /*__MSTRINGNUMBER_HPP__*/
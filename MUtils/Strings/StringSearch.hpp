@@ -0,0 +1,212 @@
+#ifndef __MSTRINGSEARCH_HPP__
+#define __MSTRINGSEARCH_HPP__
+
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MSTRING_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(__AVX2__)
+#define MSTRING_AVX2
+#include <immintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+//Length aware search primitives shared by MString and MStringView, none of them stop on '\0'.
+//Positions are returned as indices in the haystack, NotFound when there is no match.
+class MStringSearch
+{
+public:
+	static const unsigned int	NotFound = 0xFFFFFFFF;
+
+	static auto	Equal(char const* first, unsigned int firstLen, char const* second, unsigned int secondLen) -> bool
+	{
+		return firstLen == secondLen && (first == second || memcmp(first, second, firstLen) == 0);
+	}
+
+	static auto	Compare(char const* first, unsigned int firstLen, char const* second, unsigned int secondLen) -> int
+	{
+		int res = memcmp(first, second, firstLen < secondLen ? firstLen : secondLen);
+		if (res != 0)
+			return res;
+		return firstLen < secondLen ? -1 : (firstLen > secondLen ? 1 : 0);
+	}
+
+	//First occurrence of needle starting at or after from, candidates are filtered on their first and last bytes
+	static auto	Find(char const* hay, unsigned int hayLen, char const* needle, unsigned int needleLen, unsigned int from = 0) -> unsigned int
+	{
+		if (from > hayLen || needleLen > hayLen - from)
+			return NotFound;
+		if (needleLen == 0)
+			return from;
+		if (needleLen == 1)
+		{
+			const void* res = memchr(hay + from, needle[0], hayLen - from);
+			return res ? (unsigned int)((char const*)res - hay) : NotFound;
+		}
+
+		unsigned int	last = hayLen - needleLen;
+		unsigned int	pos = from;
+		char const*		inner = needle + 1;
+		unsigned int	innerLen = needleLen - 2;
+#if defined(MSTRING_AVX2)
+		__m256i	first32 = _mm256_set1_epi8(needle[0]);
+		__m256i	last32 = _mm256_set1_epi8(needle[needleLen - 1]);
+		for (; pos + 32 <= last + 1; pos += 32)
+		{
+			__m256i			blockFirst = _mm256_loadu_si256((__m256i const*)(hay + pos));
+			__m256i			blockLast = _mm256_loadu_si256((__m256i const*)(hay + pos + needleLen - 1));
+			unsigned int	mask = (unsigned int)_mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(blockFirst, first32), _mm256_cmpeq_epi8(blockLast, last32)));
+			for (; mask != 0; mask &= mask - 1)
+			{
+				unsigned int candidate = pos + LowestBit(mask);
+				if (memcmp(hay + candidate + 1, inner, innerLen) == 0)
+					return candidate;
+			}
+		}
+#endif
+#if defined(MSTRING_SSE2)
+		__m128i	first16 = _mm_set1_epi8(needle[0]);
+		__m128i	last16 = _mm_set1_epi8(needle[needleLen - 1]);
+		for (; pos + 16 <= last + 1; pos += 16)
+		{
+			__m128i			blockFirst = _mm_loadu_si128((__m128i const*)(hay + pos));
+			__m128i			blockLast = _mm_loadu_si128((__m128i const*)(hay + pos + needleLen - 1));
+			unsigned int	mask = (unsigned int)_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(blockFirst, first16), _mm_cmpeq_epi8(blockLast, last16)));
+			for (; mask != 0; mask &= mask - 1)
+			{
+				unsigned int candidate = pos + LowestBit(mask);
+				if (memcmp(hay + candidate + 1, inner, innerLen) == 0)
+					return candidate;
+			}
+		}
+#endif
+		for (; pos <= last; ++pos)
+		{
+			if (hay[pos] == needle[0] && hay[pos + needleLen - 1] == needle[needleLen - 1] && memcmp(hay + pos + 1, inner, innerLen) == 0)
+				return pos;
+		}
+		return NotFound;
+	}
+
+	//Last occurrence of needle starting at or before before
+	static auto	RFind(char const* hay, unsigned int hayLen, char const* needle, unsigned int needleLen, unsigned int before = NotFound) -> unsigned int
+	{
+		if (needleLen > hayLen)
+			return NotFound;
+		unsigned int last = hayLen - needleLen;
+		if (before < last)
+			last = before;
+		if (needleLen == 0)
+			return last;
+
+		char const*		inner = needle + 1;
+		unsigned int	innerLen = needleLen - 1;
+		//end is one past the highest candidate still to check
+		unsigned int	end = last + 1;
+#if defined(MSTRING_SSE2)
+		__m128i	first16 = _mm_set1_epi8(needle[0]);
+		__m128i	last16 = _mm_set1_epi8(needle[needleLen - 1]);
+		for (; end >= 16; end -= 16)
+		{
+			unsigned int	pos = end - 16;
+			__m128i			blockFirst = _mm_loadu_si128((__m128i const*)(hay + pos));
+			__m128i			blockLast = _mm_loadu_si128((__m128i const*)(hay + pos + needleLen - 1));
+			unsigned int	mask = (unsigned int)_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(blockFirst, first16), _mm_cmpeq_epi8(blockLast, last16)));
+			while (mask != 0)
+			{
+				unsigned int bit = HighestBit(mask);
+				if (memcmp(hay + pos + bit + 1, inner, innerLen) == 0)
+					return pos + bit;
+				mask &= ~(1u << bit);
+			}
+		}
+#endif
+		while (end-- > 0)
+		{
+			if (hay[end] == needle[0] && memcmp(hay + end + 1, inner, innerLen) == 0)
+				return end;
+		}
+		return NotFound;
+	}
+
+	//First position holding any of the chars of set
+	static auto	FindAny(char const* hay, unsigned int hayLen, char const* set, unsigned int setLen, unsigned int from = 0) -> unsigned int
+	{
+		if (setLen == 0 || from >= hayLen)
+			return NotFound;
+		if (setLen == 1)
+			return Find(hay, hayLen, set, 1, from);
+
+		unsigned int pos = from;
+#if defined(MSTRING_SSE2)
+		if (setLen <= 16)
+		{
+			__m128i	chars[16];
+			for (unsigned int idx = 0; idx < setLen; ++idx)
+				chars[idx] = _mm_set1_epi8(set[idx]);
+			for (; pos + 16 <= hayLen; pos += 16)
+			{
+				__m128i block = _mm_loadu_si128((__m128i const*)(hay + pos));
+				__m128i found = _mm_cmpeq_epi8(block, chars[0]);
+				for (unsigned int idx = 1; idx < setLen; ++idx)
+					found = _mm_or_si128(found, _mm_cmpeq_epi8(block, chars[idx]));
+				unsigned int mask = (unsigned int)_mm_movemask_epi8(found);
+				if (mask != 0)
+					return pos + LowestBit(mask);
+			}
+		}
+#endif
+		unsigned int table[8] = {};
+		for (unsigned int idx = 0; idx < setLen; ++idx)
+			table[(unsigned char)set[idx] >> 5] |= 1u << ((unsigned char)set[idx] & 31);
+		for (; pos < hayLen; ++pos)
+		{
+			unsigned char c = (unsigned char)hay[pos];
+			if (table[c >> 5] & (1u << (c & 31)))
+				return pos;
+		}
+		return NotFound;
+	}
+
+	//Number of non overlapping occurrences of needle, an empty needle never matches
+	static auto	Count(char const* hay, unsigned int hayLen, char const* needle, unsigned int needleLen) -> unsigned int
+	{
+		if (needleLen == 0)
+			return 0;
+		unsigned int res = 0;
+		for (unsigned int pos = Find(hay, hayLen, needle, needleLen); pos != NotFound; pos = Find(hay, hayLen, needle, needleLen, pos + needleLen))
+			++res;
+		return res;
+	}
+
+	//mask must not be 0
+	static auto	LowestBit(unsigned int mask) -> unsigned int
+	{
+#if defined(_MSC_VER)
+		unsigned long idx;
+		_BitScanForward(&idx, mask);
+		return (unsigned int)idx;
+#else
+		return (unsigned int)__builtin_ctz(mask);
+#endif
+	}
+
+	static auto	HighestBit(unsigned int mask) -> unsigned int
+	{
+#if defined(_MSC_VER)
+		unsigned long idx;
+		_BitScanReverse(&idx, mask);
+		return (unsigned int)idx;
+#else
+		return 31u - (unsigned int)__builtin_clz(mask);
+#endif
+	}
+};
+
+#endif /*__MSTRINGSEARCH_HPP__*/
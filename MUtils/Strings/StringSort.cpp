@@ -0,0 +1,320 @@
+#include "StringSort.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+auto	MStringSort::Order(MStringView const* keys, unsigned int count, std::vector<unsigned int>& order, bool stable, unsigned int threads) -> void
+{
+	order.resize(count);
+	if (count == 0)
+		return;
+	unsigned int workers = threads == AllThreads ? std::thread::hardware_concurrency() : threads;
+	if (workers == 0 || count < RadixThreshold * 16)
+		workers = 1;
+
+	std::vector<Entry>	entries(count);
+	std::vector<Entry>	temp(stable ? count : 0);
+	Context				context = { entries.data(), temp.data(), stable };
+	//Loading the prefixes is where every string is read, it is split evenly between the workers
+	runWorkers(workers, [&](unsigned int worker)
+	{
+		unsigned int end = (unsigned int)((unsigned long long)count * (worker + 1) / workers);
+		for (unsigned int idx = (unsigned int)((unsigned long long)count * worker / workers); idx < end; ++idx)
+			entries[idx] = Entry{ loadPrefix(keys[idx].Data(), keys[idx].Count(), 0), keys[idx].Data(), keys[idx].Count(), idx };
+	});
+
+	if (workers == 1)
+		sortGroup(context, Group{ 0, count, 0, 0 });
+	else
+	{
+		//Large groups are split on the calling thread until there are enough independent pieces
+		std::vector<Group>	pending(1, Group{ 0, count, 0, 0 });
+		std::vector<Group>	tasks;
+		unsigned int		limit = count / (workers * 8);
+		while (!pending.empty())
+		{
+			Group group = pending.back();
+			pending.pop_back();
+			if (group.count <= 1)
+				continue;
+			if (group.count <= limit || group.count < RadixThreshold)
+				tasks.push_back(group);
+			else if (group.byte == 8)
+				pending.push_back(finishPrefix(context, group));
+			else
+				radixStep(context, group, [&pending](Group sub) { pending.push_back(sub); });
+		}
+		std::sort(tasks.begin(), tasks.end(), [](Group const& first, Group const& second) { return first.count > second.count; });
+		std::atomic<unsigned int> next(0);
+		runWorkers(workers, [&](unsigned int)
+		{
+			for (unsigned int task = next++; task < tasks.size(); task = next++)
+				sortGroup(context, tasks[task]);
+		});
+	}
+
+	for (unsigned int idx = 0; idx < count; ++idx)
+		order[idx] = entries[idx].index;
+}
+
+template<class Work>
+auto	MStringSort::runWorkers(unsigned int workers, Work const& work) -> void
+{
+	std::vector<std::thread> pool;
+	for (unsigned int worker = 1; worker < workers; ++worker)
+		pool.emplace_back([&work, worker]() { work(worker); });
+	work(0);
+	for (std::thread& thread : pool)
+		thread.join();
+}
+
+auto	MStringSort::loadPrefix(char const* key, unsigned int length, unsigned int depth) -> unsigned long long
+{
+	unsigned char const*	data = (unsigned char const*)key + depth;
+	unsigned int			available = length - depth;
+	unsigned long long		prefix = 0;
+	if (available >= 8)
+	{
+		memcpy(&prefix, data, 8);
+#if defined(_MSC_VER)
+		return _byteswap_uint64(prefix);
+#elif defined(__GNUC__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+		return __builtin_bswap64(prefix);
+#else
+		prefix = 0;
+		available = 8;
+#endif
+	}
+	//Missing bytes are 0, ties between such keys are settled on their length
+	for (unsigned int idx = 0; idx < 8; ++idx)
+		prefix = (prefix << 8) | (idx < available ? data[idx] : 0);
+	return prefix;
+}
+
+auto	MStringSort::sortGroup(Context const& context, Group group) -> void
+{
+	while (group.count > 1)
+	{
+		if (group.byte == 8)
+		{
+			group = finishPrefix(context, group);
+			continue;
+		}
+		if (group.count < RadixThreshold)
+		{
+			sortSmall(context, group);
+			return;
+		}
+		//A group sharing its whole prefix is carried on by the loop instead of recursing
+		Group	same = { 0, 0, 0, 0 };
+		radixStep(context, group, [&context, &group, &same](Group sub)
+		{
+			if (sub.count == group.count)
+				same = sub;
+			else
+				sortGroup(context, sub);
+		});
+		if (same.count == 0)
+			return;
+		group = same;
+	}
+}
+
+template<class OnGroup>
+auto	MStringSort::radixStep(Context const& context, Group group, OnGroup const& onGroup) -> void
+{
+	Entry*				entries = context.entries + group.begin;
+	//Bytes shared by the whole group are skipped at once, long common prefixes would otherwise
+	//cost a counting pass per byte
+	unsigned long long	differ = 0;
+	for (unsigned int idx = 1; idx < group.count; ++idx)
+		differ |= entries[idx].prefix ^ entries[0].prefix;
+	if (differ == 0)
+	{
+		onGroup(Group{ group.begin, group.count, group.depth, 8 });
+		return;
+	}
+	unsigned int	high = (unsigned int)(differ >> 32);
+	unsigned int	topBit = high ? 32 + MStringSearch::HighestBit(high) : MStringSearch::HighestBit((unsigned int)differ);
+	group.byte = (63 - topBit) / 8;
+
+	unsigned int	shift = 56 - 8 * group.byte;
+	unsigned int	counts[256] = {};
+	for (unsigned int idx = 0; idx < group.count; ++idx)
+		++counts[(entries[idx].prefix >> shift) & 0xFF];
+
+	unsigned int	starts[256];
+	unsigned int	sum = 0;
+	for (unsigned int bucket = 0; bucket < 256; ++bucket)
+	{
+		starts[bucket] = sum;
+		sum += counts[bucket];
+	}
+
+	distribute(context, group, counts, starts, 256, [shift](Entry const& entry) { return (unsigned int)(entry.prefix >> shift) & 0xFF; });
+
+	for (unsigned int bucket = 0; bucket < 256; ++bucket)
+	{
+		if (counts[bucket] > 1)
+			onGroup(Group{ group.begin + starts[bucket], counts[bucket], group.depth, group.byte + 1 });
+	}
+}
+
+//Moves every entry of group to its bucket, starts[bucket] being the first position of bucket in the group
+template<class Digit>
+auto	MStringSort::distribute(Context const& context, Group group, unsigned int const* counts, unsigned int const* starts, unsigned int buckets, Digit const& digitOf) -> void
+{
+	Entry*			entries = context.entries + group.begin;
+	unsigned int	next[256];
+	memcpy(next, starts, buckets * sizeof(unsigned int));
+	if (context.stable)
+	{
+		//Counting sort through the scratch buffer keeps the order of equal digits
+		Entry* temp = context.temp + group.begin;
+		for (unsigned int idx = 0; idx < group.count; ++idx)
+			temp[next[digitOf(entries[idx])]++] = entries[idx];
+		memcpy(entries, temp, group.count * sizeof(Entry));
+		return;
+	}
+	//American flag sort, each entry is swapped straight into its bucket
+	for (unsigned int bucket = 0; bucket < buckets; ++bucket)
+	{
+		unsigned int end = starts[bucket] + counts[bucket];
+		while (next[bucket] < end)
+		{
+			Entry			moved = entries[next[bucket]];
+			unsigned int	digit = digitOf(moved);
+			while (digit != bucket)
+			{
+				std::swap(moved, entries[next[digit]++]);
+				digit = digitOf(moved);
+			}
+			entries[next[bucket]++] = moved;
+		}
+	}
+}
+
+//Every entry of group has the same prefix: the keys ending inside it go first by length, the others
+//load their next 8 bytes and are returned as the group left to sort
+auto	MStringSort::finishPrefix(Context const& context, Group group) -> Group
+{
+	Entry*			entries = context.entries + group.begin;
+	unsigned int	counts[10] = {};
+	for (unsigned int idx = 0; idx < group.count; ++idx)
+	{
+		unsigned int rest = entries[idx].length - group.depth;
+		++counts[rest < 9 ? rest : 9];
+	}
+	unsigned int ended = group.count - counts[9];
+	if (ended != 0)
+	{
+		unsigned int starts[10];
+		unsigned int sum = 0;
+		for (unsigned int bucket = 0; bucket < 10; ++bucket)
+		{
+			starts[bucket] = sum;
+			sum += counts[bucket];
+		}
+		unsigned int depth = group.depth;
+		distribute(context, group, counts, starts, 10, [depth](Entry const& entry)
+		{
+			unsigned int rest = entry.length - depth;
+			return rest < 9 ? rest : 9;
+		});
+	}
+
+	Group	left = { group.begin + ended, group.count - ended, group.depth + 8, 0 };
+	for (unsigned int idx = ended; idx < group.count; ++idx)
+	{
+#ifdef MSTRING_SSE2
+		if (idx + PrefetchDistance < group.count)
+			_mm_prefetch(entries[idx + PrefetchDistance].data + left.depth, _MM_HINT_T0);
+#endif
+		entries[idx].prefix = loadPrefix(entries[idx].data, entries[idx].length, left.depth);
+	}
+	return left;
+}
+
+auto	MStringSort::sortSmall(Context const& context, Group group) -> void
+{
+	if (context.stable)
+	{
+		insertionSort(context.entries + group.begin, group.count);
+		sortEqualRuns(context, group);
+	}
+	else
+		multikeyQuicksort(context, group);
+}
+
+//Stable, on the prefix only
+auto	MStringSort::insertionSort(Entry* entries, unsigned int count) -> void
+{
+	for (unsigned int idx = 1; idx < count; ++idx)
+	{
+		Entry			moved = entries[idx];
+		unsigned int	pos = idx;
+		for (; pos > 0 && entries[pos - 1].prefix > moved.prefix; --pos)
+			entries[pos] = entries[pos - 1];
+		entries[pos] = moved;
+	}
+}
+
+//Group is sorted on the prefix, runs of equal prefixes go on with the following bytes
+auto	MStringSort::sortEqualRuns(Context const& context, Group group) -> void
+{
+	Entry* entries = context.entries + group.begin;
+	for (unsigned int start = 0; start < group.count;)
+	{
+		unsigned int end = start + 1;
+		while (end < group.count && entries[end].prefix == entries[start].prefix)
+			++end;
+		if (end - start > 1)
+			sortGroup(context, Group{ group.begin + start, end - start, group.depth, 8 });
+		start = end;
+	}
+}
+
+//Three way partition on the whole prefix, the equal part moves on to the next 8 bytes
+auto	MStringSort::multikeyQuicksort(Context const& context, Group group) -> void
+{
+	while (group.count > InsertionThreshold)
+	{
+		Entry*				entries = context.entries + group.begin;
+		unsigned long long	first = entries[0].prefix;
+		unsigned long long	middle = entries[group.count / 2].prefix;
+		unsigned long long	last = entries[group.count - 1].prefix;
+		unsigned long long	pivot = std::max(std::min(first, middle), std::min(std::max(first, middle), last));
+
+		unsigned int	less = 0;
+		unsigned int	idx = 0;
+		unsigned int	greater = group.count;
+		while (idx < greater)
+		{
+			if (entries[idx].prefix < pivot)
+				std::swap(entries[less++], entries[idx++]);
+			else if (entries[idx].prefix > pivot)
+				std::swap(entries[idx], entries[--greater]);
+			else
+				++idx;
+		}
+
+		if (greater - less > 1)
+			sortGroup(context, Group{ group.begin + less, greater - less, group.depth, 8 });
+		//Recurses on the smaller side and loops on the larger one
+		Group	lower = { group.begin, less, group.depth, group.byte };
+		Group	upper = { group.begin + greater, group.count - greater, group.depth, group.byte };
+		if (lower.count < upper.count)
+		{
+			multikeyQuicksort(context, lower);
+			group = upper;
+		}
+		else
+		{
+			multikeyQuicksort(context, upper);
+			group = lower;
+		}
+	}
+	insertionSort(context.entries + group.begin, group.count);
+	sortEqualRuns(context, group);
+}
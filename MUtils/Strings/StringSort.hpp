@@ -0,0 +1,107 @@
+#ifndef __MSTRINGSORT_HPP__
+#define __MSTRINGSORT_HPP__
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "../String.hpp"
+
+//Sorts strings in byte order, the order of MString::operator<. Every key is loaded once as an 8 byte
+//big endian prefix stored next to its index, so most comparisons never touch the string data.
+//MSD radix sort splits on the prefix bytes, small groups go to a multikey quicksort (insertion sort when
+//stable) and only keys sharing a whole prefix load the next 8 bytes.
+//threads > 1 splits the work over worker threads, AllThreads uses one per hardware thread.
+class MStringSort
+{
+public:
+	static const unsigned int	AllThreads = 0;
+
+	static auto	Sort(MString* strings, unsigned int count, unsigned int threads = 1) -> void { SortBy(strings, count, identity, threads); }
+	static auto	Sort(MStringView* views, unsigned int count, unsigned int threads = 1) -> void { SortBy(views, count, identity, threads); }
+	static auto	Sort(std::vector<MString>& strings, unsigned int threads = 1) -> void { Sort(strings.data(), (unsigned int)strings.size(), threads); }
+	static auto	Sort(std::vector<MStringView>& views, unsigned int threads = 1) -> void { Sort(views.data(), (unsigned int)views.size(), threads); }
+
+	//Items with equal keys keep their relative order
+	static auto	StableSort(MString* strings, unsigned int count, unsigned int threads = 1) -> void { StableSortBy(strings, count, identity, threads); }
+	static auto	StableSort(MStringView* views, unsigned int count, unsigned int threads = 1) -> void { StableSortBy(views, count, identity, threads); }
+
+	//key(item) returns the MStringView to sort item on, it is called once per item
+	template<class T, class Key>
+	static auto	SortBy(T* items, unsigned int count, Key const& key, unsigned int threads = 1) -> void { sortBy(items, count, key, false, threads); }
+	template<class T, class Key>
+	static auto	StableSortBy(T* items, unsigned int count, Key const& key, unsigned int threads = 1) -> void { sortBy(items, count, key, true, threads); }
+
+	//Fills order so that keys[order[0]], keys[order[1]]... is sorted
+	static auto	Order(MStringView const* keys, unsigned int count, std::vector<unsigned int>& order, bool stable, unsigned int threads = 1) -> void;
+
+private:
+	//The key data is kept next to the prefix so the next prefix can be prefetched while the group is reloaded
+	struct Entry
+	{
+		unsigned long long	prefix;
+		char const*			data;
+		unsigned int		length;
+		unsigned int		index;
+	};
+
+	//Entries [begin, begin + count) share their first depth chars and the first byte bytes of their prefix
+	struct Group
+	{
+		unsigned int	begin;
+		unsigned int	count;
+		unsigned int	depth;
+		unsigned int	byte;
+	};
+
+	struct Context
+	{
+		Entry*				entries;
+		Entry*				temp;
+		bool				stable;
+	};
+
+	//Below this size groups are not split on a byte anymore
+	static const unsigned int	RadixThreshold = 64;
+	static const unsigned int	InsertionThreshold = 16;
+	static const unsigned int	PrefetchDistance = 8;
+
+	static auto	identity(MStringView view) -> MStringView { return view; }
+
+	template<class T, class Key>
+	static auto	sortBy(T* items, unsigned int count, Key const& key, bool stable, unsigned int threads) -> void
+	{
+		std::vector<MStringView> keys;
+		keys.reserve(count);
+		for (unsigned int idx = 0; idx < count; ++idx)
+			keys.push_back(key(items[idx]));
+		std::vector<unsigned int> order;
+		Order(keys.data(), count, order, stable, threads);
+		keys.clear();
+		keys.shrink_to_fit();
+		//Gathered in order then moved back, both passes write sequentially
+		std::vector<T> sorted;
+		sorted.reserve(count);
+		for (unsigned int idx = 0; idx < count; ++idx)
+			sorted.push_back(std::move(items[order[idx]]));
+		std::move(sorted.begin(), sorted.end(), items);
+	}
+
+	template<class Work>
+	static auto	runWorkers(unsigned int workers, Work const& work) -> void;
+	static auto	loadPrefix(char const* data, unsigned int length, unsigned int depth) -> unsigned long long;
+	static auto	sortGroup(Context const& context, Group group) -> void;
+	//Splits group on the first prefix byte its entries differ on and calls onGroup for every part with more
+	//than one entry, a group sharing its whole prefix is passed on as a single part
+	template<class OnGroup>
+	static auto	radixStep(Context const& context, Group group, OnGroup const& onGroup) -> void;
+	template<class Digit>
+	static auto	distribute(Context const& context, Group group, unsigned int const* counts, unsigned int const* starts, unsigned int buckets, Digit const& digitOf) -> void;
+	static auto	finishPrefix(Context const& context, Group group) -> Group;
+	static auto	sortSmall(Context const& context, Group group) -> void;
+	static auto	insertionSort(Entry* entries, unsigned int count) -> void;
+	static auto	sortEqualRuns(Context const& context, Group group) -> void;
+	static auto	multikeyQuicksort(Context const& context, Group group) -> void;
+};
+
+#endif /*__MSTRINGSORT_HPP__*/
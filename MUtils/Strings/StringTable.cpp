@@ -0,0 +1,181 @@
+#include "StringTable.hpp"
+
+#include <cstdio>
+
+auto	MStringTable::Add(MStringView str) -> unsigned int
+{
+	unsigned int	hash = hashOf(str);
+	unsigned int	id = find(str, hash);
+	if (id != NotFound)
+		return id;
+
+	useOwned();
+	if ((count + 1) * 2 > slotCount)
+		grow();
+	id = count++;
+	charArray.insert(charArray.end(), str.begin(), str.end());
+	charArray.push_back('\0');
+	offsetArray.push_back((unsigned int)charArray.size());
+	place(slotArray, Slot{ hash, id });
+	useOwned();
+	return id;
+}
+
+auto	MStringTable::Clear() -> void
+{
+	file.Close();
+	slotArray.clear();
+	offsetArray.assign(1, 0);
+	charArray.clear();
+	count = 0;
+	slotCount = 0;
+	useOwned();
+}
+
+//Ids and offsets of a damaged file are clamped to an empty string
+auto	MStringTable::String(unsigned int id) const -> MStringView
+{
+	if (id >= count || offsets[id] >= offsets[id + 1] || offsets[id + 1] > offsets[count])
+		return MStringView();
+	return MStringView(chars + offsets[id], offsets[id + 1] - offsets[id] - 1);
+}
+
+auto	MStringTable::Save(char const* path) const -> bool
+{
+#ifdef _WIN32
+	FILE* out = _wfopen(MWString::FromUTF8(path).Str(), L"wb");
+#else
+	FILE* out = fopen(path, "wb");
+#endif
+	if (!out)
+		return false;
+	FileHeader		header = { { 'M', 'S', 'T', 'B' }, Version, count, offsets[count], slotCount, {} };
+	bool			written = fwrite(&header, sizeof(header), 1, out) == 1
+		&& (slotCount == 0 || fwrite(slots, sizeof(Slot), slotCount, out) == slotCount)
+		&& fwrite(offsets, sizeof(unsigned int), count + 1, out) == count + 1
+		&& fwrite(chars, 1, offsets[count], out) == offsets[count];
+	return fclose(out) == 0 && written;
+}
+
+auto	MStringTable::Load(char const* path) -> bool
+{
+	Clear();
+	if (!file.Open(path) || file.Size() < sizeof(FileHeader))
+	{
+		file.Close();
+		return false;
+	}
+	FileHeader header;
+	memcpy(&header, file.Data(), sizeof(header));
+	unsigned long long	expected = sizeof(FileHeader) + sizeof(Slot) * (unsigned long long)header.slotCount + 4ull * (header.count + 1ull) + header.charCount;
+	//Probing stops on an empty slot, there have to be more slots than strings
+	bool				validSlots = (header.slotCount & (header.slotCount - 1)) == 0 && (header.slotCount > header.count || (header.slotCount == 0 && header.count == 0));
+	if (memcmp(header.magic, "MSTB", 4) != 0 || header.version != Version || file.Size() != expected || !validSlots)
+	{
+		file.Close();
+		return false;
+	}
+	//Mapped views are page aligned, the slots and the offsets land on a 4 bytes boundary
+	slots = (Slot const*)(file.Data() + sizeof(FileHeader));
+	offsets = (unsigned int const*)(slots + header.slotCount);
+	chars = (char const*)(offsets + header.count + 1);
+	count = header.count;
+	slotCount = header.slotCount;
+
+	//Only both ends of the offsets and the last char are read here, the entries in between are bounded where
+	//the queries use them
+	if (offsets[0] != 0 || offsets[count] != header.charCount || (header.charCount && chars[header.charCount - 1] != '\0'))
+	{
+		Clear();
+		return false;
+	}
+	return true;
+}
+
+auto	MStringTable::Verify() const -> bool
+{
+	bool valid = offsets[0] == 0;
+	for (unsigned int id = 0; valid && id < count; ++id)
+		valid = offsets[id] < offsets[id + 1] && chars[offsets[id + 1] - 1] == '\0';
+
+	//Every string is in exactly one slot with its hash, the other slots are empty so probing always stops
+	std::vector<bool>	seen(valid ? count : 0, false);
+	unsigned int		used = 0;
+	for (unsigned int idx = 0; valid && idx < slotCount; ++idx)
+	{
+		Slot const& slot = slots[idx];
+		if (slot.id == NotFound)
+			continue;
+		valid = slot.id < count && !seen[slot.id] && slot.hash == hashOf(String(slot.id));
+		if (valid)
+			seen[slot.id] = true;
+		++used;
+	}
+	return valid && used == count && (used < slotCount || slotCount == 0);
+}
+
+auto	MStringTable::find(MStringView str, unsigned int hash) const -> unsigned int
+{
+	unsigned int mask = slotCount - 1;
+	unsigned int idx = hash & mask;
+	//A damaged file may have no empty slot, one pass over the slots bounds the probing
+	for (unsigned int probe = 0; probe < slotCount; ++probe, idx = (idx + 1) & mask)
+	{
+		Slot const& slot = slots[idx];
+		if (slot.id == NotFound)
+			return NotFound;
+		if (slot.hash == hash && slot.id < count && String(slot.id) == str)
+			return slot.id;
+	}
+	return NotFound;
+}
+
+auto	MStringTable::grow() -> void
+{
+	std::vector<Slot> grown(slotCount ? slotCount * 2 : MinSlots, Slot{ 0, NotFound });
+	for (Slot const& slot : slotArray)
+	{
+		if (slot.id != NotFound)
+			place(grown, slot);
+	}
+	slotArray.swap(grown);
+	slotCount = (unsigned int)slotArray.size();
+}
+
+auto	MStringTable::useOwned() -> void
+{
+	bool mapped = file.IsOpen();
+	if (mapped)
+	{
+		offsetArray.assign(offsets, offsets + count + 1);
+		charArray.assign(chars, chars + offsets[count]);
+		file.Close();
+	}
+	offsets = offsetArray.data();
+	chars = charArray.empty() ? "" : charArray.data();
+	//The slots are rebuilt from the strings rather than copied, those of a damaged file may have no empty one left.
+	//Load checked there are more slots than strings.
+	if (mapped)
+	{
+		slotArray.assign(slotCount, Slot{ 0, NotFound });
+		for (unsigned int id = 0; id < count; ++id)
+			place(slotArray, Slot{ hashOf(String(id)), id });
+	}
+	slots = slotArray.data();
+}
+
+auto	MStringTable::place(std::vector<Slot>& into, Slot slot) -> void
+{
+	unsigned int mask = (unsigned int)into.size() - 1;
+	unsigned int idx = slot.hash & mask;
+	while (into[idx].id != NotFound)
+		idx = (idx + 1) & mask;
+	into[idx] = slot;
+}
+
+//Folds the 64 bits MStringHash
+auto	MStringTable::hashOf(MStringView str) -> unsigned int
+{
+	unsigned long long hash = str.Hash();
+	return (unsigned int)(hash ^ (hash >> 32));
+}
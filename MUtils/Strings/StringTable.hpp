@@ -0,0 +1,86 @@
+#ifndef __MSTRINGTABLE_HPP__
+#define __MSTRINGTABLE_HPP__
+
+#include <vector>
+
+#include "../String.hpp"
+#include "MappedFile.hpp"
+
+//Table of unique strings stored one after the other in a single char array, each followed by a '\0', with an
+//offsets array and an open addressing hash index. Saved tables are loaded by mapping the file and queried in
+//place: nothing is parsed, allocated, rehashed or read before the queries touch it.
+class MStringTable
+{
+public:
+	static const unsigned int	NotFound = 0xFFFFFFFF;
+
+	MStringTable() = default;
+	MStringTable(MStringTable const&) = delete;
+	auto	operator=(MStringTable const&) -> MStringTable& = delete;
+
+	//Returns the id of str, adding it when it is not in the table yet. Ids are given in order from 0.
+	//Adding to a loaded table copies it out of the file first. All the strings must stay under 4 GB.
+	auto	Add(MStringView str) -> unsigned int;
+	auto	Clear() -> void;
+
+	auto	Count() const -> unsigned int { return count; }
+	//The view points in the table and is followed by a '\0'
+	auto	String(unsigned int id) const -> MStringView;
+	auto	Find(MStringView str) const -> unsigned int { return find(str, hashOf(str)); }
+	auto	Contains(MStringView str) const -> bool { return Find(str) != NotFound; }
+
+	//Paths are UTF-8. The file layout is native endian, Load rejects files written with another one.
+	auto	Save(char const* path) const -> bool;
+	//Replaces the current table. Only the header and the sizes are checked, queries on a damaged file stay in bounds
+	//and always stop but their results are wrong until Verify fails.
+	auto	Load(char const* path) -> bool;
+	//Checks the offsets against the chars and the slots against the strings, reading the whole table once
+	auto	Verify() const -> bool;
+	auto	IsMapped() const -> bool { return file.IsOpen(); }
+
+private:
+	//Written at the start of saved files, followed by the slots, the offsets and the chars
+	struct FileHeader
+	{
+		char			magic[4];
+		unsigned int	version;
+		unsigned int	count;
+		unsigned int	charCount;
+		unsigned int	slotCount;
+		unsigned int	reserved[3];
+	};
+
+	struct Slot
+	{
+		unsigned int	hash;
+		unsigned int	id;
+	};
+
+	//Bumped with the layout or with MStringHash since saved slots hold its values
+	static const unsigned int	Version = 1;
+	static const unsigned int	MinSlots = 64;
+
+	auto	find(MStringView str, unsigned int hash) const -> unsigned int;
+	auto	grow() -> void;
+	//Points the queries at the vectors, a mapped table is copied first
+	auto	useOwned() -> void;
+
+	//Stores slot in the first empty slot from its hash, there has to be one
+	static auto	place(std::vector<Slot>& into, Slot slot) -> void;
+
+	static auto	hashOf(MStringView str) -> unsigned int;
+
+	std::vector<Slot>			slotArray;
+	std::vector<unsigned int>	offsetArray = std::vector<unsigned int>(1, 0);
+	std::vector<char>			charArray;
+	MMappedFile					file;
+
+	//Owned vectors or the mapped file
+	Slot const*					slots = nullptr;
+	unsigned int const*			offsets = offsetArray.data();
+	char const*					chars = "";
+	unsigned int				count = 0;
+	unsigned int				slotCount = 0;
+};
+
+#endif /*__MSTRINGTABLE_HPP__*/
@@ -0,0 +1,339 @@
+#ifndef __MSTRINGUTF_HPP__
+#define __MSTRINGUTF_HPP__
+
+#include "StringSearch.hpp"
+
+//Locale free UTF-8 <-> UTF-16 / UTF-32 transcoding over explicit lengths.
+//The Length functions give the exact output size so the destination can be allocated once, the conversions
+//then write straight into it. Ill formed input (overlong forms, surrogates in UTF-8 or UTF-32, lone surrogates
+//in UTF-16, code points above U+10FFFF) is replaced by U+FFFD, one per maximal invalid subpart.
+//wchar_t is UTF-16 when it is 16 bits wide (Windows) and UTF-32 otherwise.
+class MStringUTF
+{
+public:
+	static const unsigned int	Replacement = 0xFFFD;
+	static const unsigned int	InvalidCodePoint = 0xFFFFFFFF;
+
+	static auto	ValidateUTF8(char const* str, unsigned int count) -> bool
+	{
+		unsigned char const*	src = (unsigned char const*)str;
+		unsigned int			pos = 0;
+		while (pos < count)
+		{
+			pos = skipASCII(src, count, pos);
+			if (pos == count)
+				break;
+			unsigned int codePoint;
+			pos += decodeUTF8(src + pos, count - pos, codePoint);
+			if (codePoint == InvalidCodePoint)
+				return false;
+		}
+		return true;
+	}
+
+	static auto	UTF16Length(char const* utf8, unsigned int count) -> unsigned int { return fromUTF8<char16_t, false>(utf8, count, nullptr); }
+	static auto	UTF32Length(char const* utf8, unsigned int count) -> unsigned int { return fromUTF8<char32_t, false>(utf8, count, nullptr); }
+	static auto	WideLength(char const* utf8, unsigned int count) -> unsigned int { return fromUTF8<wchar_t, false>(utf8, count, nullptr); }
+
+	//out must hold the matching Length() units, no terminator is written. Returns the number of units written.
+	static auto	UTF8ToUTF16(char const* utf8, unsigned int count, char16_t* out) -> unsigned int { return fromUTF8<char16_t, true>(utf8, count, out); }
+	static auto	UTF8ToUTF32(char const* utf8, unsigned int count, char32_t* out) -> unsigned int { return fromUTF8<char32_t, true>(utf8, count, out); }
+	static auto	UTF8ToWide(char const* utf8, unsigned int count, wchar_t* out) -> unsigned int { return fromUTF8<wchar_t, true>(utf8, count, out); }
+
+	static auto	UTF8Length(char16_t const* str, unsigned int count) -> unsigned int { return toUTF8<char16_t, false>(str, count, nullptr); }
+	static auto	UTF8Length(char32_t const* str, unsigned int count) -> unsigned int { return toUTF8<char32_t, false>(str, count, nullptr); }
+	static auto	UTF8Length(wchar_t const* str, unsigned int count) -> unsigned int { return toUTF8<wchar_t, false>(str, count, nullptr); }
+
+	//out must hold the matching UTF8Length() chars, no terminator is written. Returns the number of chars written.
+	static auto	UTF16ToUTF8(char16_t const* str, unsigned int count, char* out) -> unsigned int { return toUTF8<char16_t, true>(str, count, out); }
+	static auto	UTF32ToUTF8(char32_t const* str, unsigned int count, char* out) -> unsigned int { return toUTF8<char32_t, true>(str, count, out); }
+	static auto	WideToUTF8(wchar_t const* str, unsigned int count, char* out) -> unsigned int { return toUTF8<wchar_t, true>(str, count, out); }
+
+	//Decodes one code point, InvalidCodePoint for an ill formed sequence. Returns the number of bytes consumed
+	//(at least 1 when count is not 0), an ill formed sequence stops before the first byte that breaks it.
+	static auto	DecodeUTF8(char const* str, unsigned int count, unsigned int& codePoint) -> unsigned int
+	{
+		return decodeUTF8((unsigned char const*)str, count, codePoint);
+	}
+
+	//out must have room for 4 chars, returns the number written
+	static auto	EncodeUTF8(unsigned int codePoint, char* out) -> unsigned int { return encodeUTF8<true>(codePoint, out, 0); }
+
+private:
+	//Index of the first byte >= 0x80 at or after pos
+	static auto	skipASCII(unsigned char const* src, unsigned int count, unsigned int pos) -> unsigned int
+	{
+#ifdef MSTRING_SSE2
+		for (; pos + 16 <= count; pos += 16)
+		{
+			int mask = _mm_movemask_epi8(_mm_loadu_si128((__m128i const*)(src + pos)));
+			if (mask != 0)
+				return pos + MStringSearch::LowestBit((unsigned int)mask);
+		}
+#endif
+		while (pos < count && src[pos] < 0x80)
+			++pos;
+		return pos;
+	}
+
+	//Decodes the sequence at src, codePoint is InvalidCodePoint when it is ill formed.
+	//Returns the number of bytes consumed, which stops before the first byte that breaks the sequence.
+	static auto	decodeUTF8(unsigned char const* src, unsigned int count, unsigned int& codePoint) -> unsigned int
+	{
+		unsigned int	lead = src[0];
+		unsigned int	trailing;
+		unsigned char	low = 0x80;
+		unsigned char	high = 0xBF;
+		if (lead < 0x80)
+		{
+			codePoint = lead;
+			return 1;
+		}
+		else if (lead >= 0xC2 && lead <= 0xDF)
+		{
+			trailing = 1;
+			codePoint = lead & 0x1F;
+		}
+		else if (lead >= 0xE0 && lead <= 0xEF)
+		{
+			trailing = 2;
+			codePoint = lead & 0x0F;
+			if (lead == 0xE0)
+				low = 0xA0;
+			else if (lead == 0xED)
+				high = 0x9F;
+		}
+		else if (lead >= 0xF0 && lead <= 0xF4)
+		{
+			trailing = 3;
+			codePoint = lead & 0x07;
+			if (lead == 0xF0)
+				low = 0x90;
+			else if (lead == 0xF4)
+				high = 0x8F;
+		}
+		else
+		{
+			codePoint = InvalidCodePoint;
+			return 1;
+		}
+
+		for (unsigned int idx = 1; idx <= trailing; ++idx)
+		{
+			if (idx >= count || src[idx] < low || src[idx] > high)
+			{
+				codePoint = InvalidCodePoint;
+				return idx;
+			}
+			codePoint = (codePoint << 6) | (src[idx] & 0x3F);
+			low = 0x80;
+			high = 0xBF;
+		}
+		return trailing + 1;
+	}
+
+	template<class Char, bool Write>
+	static auto	fromUTF8(char const* str, unsigned int count, Char* out) -> unsigned int
+	{
+		unsigned char const*	src = (unsigned char const*)str;
+		unsigned int			pos = 0;
+		unsigned int			written = 0;
+		while (pos < count)
+		{
+#ifdef MSTRING_SSE2
+			//Whole blocks of ASCII are widened with unpacks, a partial block is copied up to its first non ASCII byte
+			if (pos + 16 <= count)
+			{
+				__m128i	bytes = _mm_loadu_si128((__m128i const*)(src + pos));
+				int		mask = _mm_movemask_epi8(bytes);
+				if (mask == 0)
+				{
+					if (Write)
+						widen(bytes, out + written, sizeof(Char));
+					pos += 16;
+					written += 16;
+					continue;
+				}
+				unsigned int ascii = MStringSearch::LowestBit((unsigned int)mask);
+				for (unsigned int idx = 0; Write && idx < ascii; ++idx)
+					out[written + idx] = (Char)src[pos + idx];
+				pos += ascii;
+				written += ascii;
+			}
+			else
+#endif
+			{
+				for (; pos < count && src[pos] < 0x80; ++pos, ++written)
+				{
+					if (Write)
+						out[written] = (Char)src[pos];
+				}
+				if (pos == count)
+					break;
+			}
+
+			unsigned int codePoint;
+			pos += decodeUTF8(src + pos, count - pos, codePoint);
+			if (codePoint == InvalidCodePoint)
+				codePoint = Replacement;
+			if (sizeof(Char) == 2 && codePoint >= 0x10000)
+			{
+				if (Write)
+				{
+					out[written] = (Char)(0xD7C0 + (codePoint >> 10));
+					out[written + 1] = (Char)(0xDC00 | (codePoint & 0x3FF));
+				}
+				written += 2;
+			}
+			else
+			{
+				if (Write)
+					out[written] = (Char)codePoint;
+				++written;
+			}
+		}
+		return written;
+	}
+
+	template<class Char, bool Write>
+	static auto	toUTF8(Char const* src, unsigned int count, char* out) -> unsigned int
+	{
+		unsigned int	pos = 0;
+		unsigned int	written = 0;
+		while (pos < count)
+		{
+#ifdef MSTRING_SSE2
+			//Blocks of 8 ASCII units are narrowed with packs, other blocks are converted one code point at a time
+			if (pos + 8 <= count)
+			{
+				if (narrow(src + pos, Write ? out + written : nullptr, sizeof(Char)))
+				{
+					pos += 8;
+					written += 8;
+					continue;
+				}
+				for (unsigned int blockEnd = pos + 8; pos < blockEnd;)
+					written += encodeUTF8<Write>(readCodePoint(src, count, pos), out, written);
+				continue;
+			}
+#endif
+			written += encodeUTF8<Write>(readCodePoint(src, count, pos), out, written);
+		}
+		return written;
+	}
+
+	//Reads the code point at pos and moves past it, a surrogate pair counts as one code point in UTF-16
+	template<class Char>
+	static auto	readCodePoint(Char const* src, unsigned int count, unsigned int& pos) -> unsigned int
+	{
+		unsigned int codePoint = toUnsigned(src[pos++]);
+		if (codePoint < 0xD800)
+			return codePoint;
+		if (sizeof(Char) == 2 && codePoint <= 0xDBFF && pos < count)
+		{
+			unsigned int next = toUnsigned(src[pos]);
+			if (next >= 0xDC00 && next <= 0xDFFF)
+			{
+				++pos;
+				return 0x10000 + ((codePoint - 0xD800) << 10) + (next - 0xDC00);
+			}
+		}
+		if (codePoint <= 0xDFFF || codePoint > 0x10FFFF)
+			return Replacement;
+		return codePoint;
+	}
+
+	template<bool Write>
+	static auto	encodeUTF8(unsigned int codePoint, char* out, unsigned int pos) -> unsigned int
+	{
+		if (codePoint < 0x80)
+		{
+			if (Write)
+				out[pos] = (char)codePoint;
+			return 1;
+		}
+		if (codePoint < 0x800)
+		{
+			if (Write)
+			{
+				out[pos] = (char)(0xC0 | (codePoint >> 6));
+				out[pos + 1] = (char)(0x80 | (codePoint & 0x3F));
+			}
+			return 2;
+		}
+		if (codePoint < 0x10000)
+		{
+			if (Write)
+			{
+				out[pos] = (char)(0xE0 | (codePoint >> 12));
+				out[pos + 1] = (char)(0x80 | ((codePoint >> 6) & 0x3F));
+				out[pos + 2] = (char)(0x80 | (codePoint & 0x3F));
+			}
+			return 3;
+		}
+		if (Write)
+		{
+			out[pos] = (char)(0xF0 | (codePoint >> 18));
+			out[pos + 1] = (char)(0x80 | ((codePoint >> 12) & 0x3F));
+			out[pos + 2] = (char)(0x80 | ((codePoint >> 6) & 0x3F));
+			out[pos + 3] = (char)(0x80 | (codePoint & 0x3F));
+		}
+		return 4;
+	}
+
+	//wchar_t may be signed, negative values must end up invalid rather than ASCII
+	static auto	toUnsigned(char16_t unit) -> unsigned int { return unit; }
+	static auto	toUnsigned(char32_t unit) -> unsigned int { return unit; }
+	static auto	toUnsigned(wchar_t unit) -> unsigned int { return sizeof(wchar_t) == 2 ? (unsigned int)(unsigned short)unit : (unsigned int)unit; }
+
+#ifdef MSTRING_SSE2
+	//Zero extends 16 ASCII bytes to 16 units of unitSize bytes
+	static auto	widen(__m128i bytes, void* out, unsigned int unitSize) -> void
+	{
+		__m128i	zero = _mm_setzero_si128();
+		__m128i	low = _mm_unpacklo_epi8(bytes, zero);
+		__m128i	high = _mm_unpackhi_epi8(bytes, zero);
+		__m128i* dst = (__m128i*)out;
+		if (unitSize == 2)
+		{
+			_mm_storeu_si128(dst, low);
+			_mm_storeu_si128(dst + 1, high);
+			return;
+		}
+		_mm_storeu_si128(dst, _mm_unpacklo_epi16(low, zero));
+		_mm_storeu_si128(dst + 1, _mm_unpackhi_epi16(low, zero));
+		_mm_storeu_si128(dst + 2, _mm_unpacklo_epi16(high, zero));
+		_mm_storeu_si128(dst + 3, _mm_unpackhi_epi16(high, zero));
+	}
+
+	//Packs 8 units of unitSize bytes to 8 chars when they are all ASCII, out may be nullptr to only check
+	static auto	narrow(void const* src, char* out, unsigned int unitSize) -> bool
+	{
+		__m128i const*	units = (__m128i const*)src;
+		__m128i			zero = _mm_setzero_si128();
+		__m128i			packed;
+		if (unitSize == 2)
+		{
+			packed = _mm_loadu_si128(units);
+			if (_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(packed, _mm_set1_epi16((short)0xFF80)), zero)) != 0xFFFF)
+				return false;
+		}
+		else
+		{
+			__m128i	low = _mm_loadu_si128(units);
+			__m128i	high = _mm_loadu_si128(units + 1);
+			__m128i	nonASCII = _mm_set1_epi32((int)0xFFFFFF80);
+			int		lowMask = _mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(low, nonASCII), zero));
+			int		highMask = _mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(high, nonASCII), zero));
+			if ((lowMask & highMask) != 0xFFFF)
+				return false;
+			packed = _mm_packs_epi32(low, high);
+		}
+		if (out)
+			_mm_storel_epi64((__m128i*)out, _mm_packus_epi16(packed, packed));
+		return true;
+	}
+#endif
+};
+
+#endif /*__MSTRINGUTF_HPP__*/
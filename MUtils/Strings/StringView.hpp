@@ -0,0 +1,212 @@
+#ifndef __MSTRINGVIEW_HPP__
+#define __MSTRINGVIEW_HPP__
+
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "StringCase.hpp"
+#include "StringFold.hpp"
+#include "StringHash.hpp"
+#include "StringNumber.hpp"
+#include "StringSearch.hpp"
+
+#if __cplusplus >= 201703L || (defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+#define MSTRING_HAS_STRING_VIEW
+#include <string_view>
+#endif
+
+class MStringTokenizer;
+
+//Non owning pointer + length over chars, the data is not required to be NUL terminated
+class MStringView
+{
+public:
+	static const unsigned int	Npos = MStringSearch::NotFound;
+
+	MStringView() = default;
+	MStringView(const char* str) : data(str), count((unsigned int)strlen(str)) {}
+	MStringView(const char* str, unsigned int length) : data(str), count(length) {}
+	MStringView(std::string const& str) : data(str.data()), count((unsigned int)str.size()) {}
+
+#ifdef MSTRING_HAS_STRING_VIEW
+	MStringView(std::string_view str) : data(str.data()), count((unsigned int)str.size()) {}
+	operator std::string_view() const { return std::string_view(data, count); }
+#endif
+
+	auto	Data() const -> char const* { return data; }
+	auto	Count() const -> unsigned int { return count; }
+	auto	IsEmpty() const -> bool { return count == 0; }
+
+	auto	operator[](unsigned int idx) const -> char { return data[idx]; }
+	auto	begin() const -> char const* { return data; }
+	auto	end() const -> char const* { return data + count; }
+
+	auto	Find(char value, unsigned int from = 0) const -> unsigned int
+	{
+		if (from >= count)
+			return Npos;
+		const void* res = memchr(data + from, value, count - from);
+		return res ? (unsigned int)((char const*)res - data) : Npos;
+	}
+
+	auto	Find(MStringView sub, unsigned int from = 0) const -> unsigned int { return MStringSearch::Find(data, count, sub.data, sub.count, from); }
+	auto	RFind(MStringView sub, unsigned int before = Npos) const -> unsigned int { return MStringSearch::RFind(data, count, sub.data, sub.count, before); }
+	auto	FindAny(MStringView chars, unsigned int from = 0) const -> unsigned int { return MStringSearch::FindAny(data, count, chars.data, chars.count, from); }
+	//Number of non overlapping occurrences of sub
+	auto	Count(MStringView sub) const -> unsigned int { return MStringSearch::Count(data, count, sub.data, sub.count); }
+	auto	Contains(MStringView sub) const -> bool { return Find(sub) != Npos; }
+
+	//ASCII only, see MStringCase
+	auto	EqualsIgnoreCase(MStringView other) const -> bool { return MStringCase::Equal(data, count, other.data, other.count); }
+	auto	CompareIgnoreCase(MStringView other) const -> int { return MStringCase::Compare(data, count, other.data, other.count); }
+	auto	FindIgnoreCase(MStringView sub, unsigned int from = 0) const -> unsigned int { return MStringCase::Find(data, count, sub.data, sub.count, from); }
+	auto	ContainsIgnoreCase(MStringView sub) const -> bool { return FindIgnoreCase(sub) != Npos; }
+
+	//Whitespace is ASCII space, \t, \n, \v, \f and \r
+	auto	TrimStart() const -> MStringView
+	{
+		unsigned int idx = 0;
+		while (idx < count && isSpace(data[idx]))
+			++idx;
+		return MStringView(data + idx, count - idx);
+	}
+
+	auto	TrimEnd() const -> MStringView
+	{
+		unsigned int length = count;
+		while (length > 0 && isSpace(data[length - 1]))
+			--length;
+		return MStringView(data, length);
+	}
+
+	auto	Trim() const -> MStringView { return TrimStart().TrimEnd(); }
+
+	auto	StartsWith(MStringView prefix) const -> bool { return prefix.count <= count && memcmp(data, prefix.data, prefix.count) == 0; }
+	auto	EndsWith(MStringView suffix) const -> bool { return suffix.count <= count && memcmp(data + count - suffix.count, suffix.data, suffix.count) == 0; }
+
+	//length is clamped to the end of the view
+	auto	Substr(unsigned int idx, unsigned int length = Npos) const -> MStringView
+	{
+		if (idx > count)
+			idx = count;
+		if (length > count - idx)
+			length = count - idx;
+		return MStringView(data + idx, length);
+	}
+
+	auto	Hash() const -> unsigned long long { return MStringHash::Hash(data, count); }
+
+	//Unicode simple case folding of UTF-8 content, no folded copy is built
+	auto	EqualsFolded(MStringView other) const -> bool { return MStringFold::Equal(data, count, other.data, other.count); }
+	auto	HashFolded() const -> unsigned long long { return MStringFold::Hash(data, count); }
+
+	//Parse from the start of the view, return the number of chars consumed, 0 when no number could be read
+	auto	ParseInt(long long& value) const -> unsigned int { return MStringNumber::ParseInt(data, count, value); }
+	auto	ParseInt(int& value) const -> unsigned int { return MStringNumber::ParseInt(data, count, value); }
+	auto	ParseUInt(unsigned long long& value) const -> unsigned int { return MStringNumber::ParseUInt(data, count, value); }
+	auto	ParseUInt(unsigned int& value) const -> unsigned int { return MStringNumber::ParseUInt(data, count, value); }
+	auto	ParseFloat(float& value) const -> unsigned int { return MStringNumber::ParseFloat(data, count, value); }
+
+	auto	Split(MStringView sep, MStringView& left, MStringView& right) const -> bool
+	{
+		unsigned int idx = Find(sep);
+		if (idx == Npos)
+			return false;
+		left = MStringView(data, idx);
+		right = MStringView(data + idx + sep.count, count - idx - sep.count);
+		return true;
+	}
+
+	//Clears tokens then fills it with every part between separators, empty parts included
+	auto	SplitAll(MStringView sep, std::vector<MStringView>& tokens) const -> unsigned int;
+
+	auto	Tokenize(MStringView sep, bool skipEmpty = false) const -> MStringTokenizer;
+
+	friend bool	operator==(MStringView first, MStringView second) { return MStringSearch::Equal(first.data, first.count, second.data, second.count); }
+	friend bool	operator!=(MStringView first, MStringView second) { return !(first == second); }
+	friend bool	operator<(MStringView first, MStringView second) { return MStringSearch::Compare(first.data, first.count, second.data, second.count) < 0; }
+
+private:
+	static auto	isSpace(char c) -> bool { return c == ' ' || (unsigned char)(c - '\t') <= '\r' - '\t'; }
+
+	char const*		data = "";
+	unsigned int	count = 0;
+};
+
+//Lazily walks the tokens of a view, no allocation is made
+class MStringTokenizer
+{
+public:
+	class Iterator
+	{
+	public:
+		Iterator(MStringTokenizer const* owner, unsigned int pos) : owner(owner), pos(pos) { next(); }
+
+		auto	operator*() const -> MStringView const& { return token; }
+		auto	operator->() const -> MStringView const* { return &token; }
+		auto	operator++() -> Iterator& { next(); return *this; }
+		auto	operator==(Iterator const& other) const -> bool { return pos == other.pos; }
+		auto	operator!=(Iterator const& other) const -> bool { return pos != other.pos; }
+
+	private:
+		auto	next() -> void
+		{
+			MStringView const&	text = owner->text;
+			while (pos != MStringView::Npos)
+			{
+				if (pos > text.Count())
+				{
+					pos = MStringView::Npos;
+					return;
+				}
+				unsigned int end = owner->sep.IsEmpty() ? MStringView::Npos : text.Find(owner->sep, pos);
+				if (end == MStringView::Npos)
+					end = text.Count();
+				token = text.Substr(pos, end - pos);
+				pos = end + (owner->sep.Count() ? owner->sep.Count() : 1);
+				if (!owner->skipEmpty || !token.IsEmpty())
+					return;
+			}
+		}
+
+		MStringTokenizer const*	owner;
+		unsigned int			pos;
+		MStringView				token;
+	};
+
+	MStringTokenizer(MStringView text, MStringView sep, bool skipEmpty = false) : text(text), sep(sep), skipEmpty(skipEmpty) {}
+
+	auto	begin() const -> Iterator { return Iterator(this, 0); }
+	auto	end() const -> Iterator { return Iterator(this, MStringView::Npos); }
+
+private:
+	MStringView	text;
+	MStringView	sep;
+	bool		skipEmpty;
+};
+
+inline auto	MStringView::SplitAll(MStringView sep, std::vector<MStringView>& tokens) const -> unsigned int
+{
+	tokens.clear();
+	for (MStringView token : Tokenize(sep))
+		tokens.push_back(token);
+	return (unsigned int)tokens.size();
+}
+
+inline auto	MStringView::Tokenize(MStringView sep, bool skipEmpty) const -> MStringTokenizer
+{
+	return MStringTokenizer(*this, sep, skipEmpty);
+}
+
+namespace std
+{
+	template<>
+	struct hash<MStringView>
+	{
+		size_t	operator()(MStringView str) const { return (size_t)str.Hash(); }
+	};
+}
+
+#endif /*__MSTRINGVIEW_HPP__*/
@@ -0,0 +1,402 @@
+#include "SubstringIndex.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <thread>
+
+auto	MSubstringIndex::AddDocument(MStringView document) -> unsigned int
+{
+	useOwned();
+	built = false;
+	suffixArray.clear();
+	lcpArray.clear();
+	corpus.insert(corpus.end(), document.begin(), document.end());
+	corpus.push_back('\0');
+	documentStarts.push_back((unsigned int)corpus.size());
+	++documentCount;
+	useOwned();
+	return documentCount - 1;
+}
+
+auto	MSubstringIndex::Build(unsigned int threads) -> void
+{
+	useOwned();
+	unsigned int count = (unsigned int)corpus.size();
+	suffixArray.resize(count);
+	lcpArray.resize(count);
+	sais((unsigned char const*)corpus.data(), count, 256, suffixArray.data());
+
+	unsigned int workers = threads == AllThreads ? std::thread::hardware_concurrency() : threads;
+	if (workers == 0 || count < (1u << 16))
+		workers = 1;
+	//Permuted LCP (Karkkainen, Manzini, Puglisi): walking the text in order, the common prefix with the previous
+	//suffix shrinks by at most one per step. Each worker walks its own part of the text and only restarts from 0.
+	//Common prefixes stop at a separator so they never span two documents.
+	std::vector<unsigned int>	previous(count);
+	char const*					data = corpus.data();
+	unsigned int const*			sorted = suffixArray.data();
+	if (count)
+		previous[sorted[0]] = Empty;
+	for (unsigned int idx = 1; idx < count; ++idx)
+		previous[sorted[idx]] = sorted[idx - 1];
+	runWorkers(workers, [&](unsigned int worker)
+	{
+		unsigned int	end = (unsigned int)((unsigned long long)count * (worker + 1) / workers);
+		unsigned int	common = 0;
+		for (unsigned int pos = (unsigned int)((unsigned long long)count * worker / workers); pos < end; ++pos)
+		{
+			unsigned int other = previous[pos];
+			if (other == Empty)
+			{
+				previous[pos] = 0;
+				common = 0;
+				continue;
+			}
+			while (pos + common < count && other + common < count && data[pos + common] == data[other + common] && data[pos + common] != '\0')
+				++common;
+			previous[pos] = common;
+			if (common > 0)
+				--common;
+		}
+	});
+	runWorkers(workers, [&](unsigned int worker)
+	{
+		unsigned int end = (unsigned int)((unsigned long long)count * (worker + 1) / workers);
+		for (unsigned int idx = (unsigned int)((unsigned long long)count * worker / workers); idx < end; ++idx)
+			lcpArray[idx] = previous[sorted[idx]];
+	});
+	built = true;
+	useOwned();
+}
+
+auto	MSubstringIndex::Clear() -> void
+{
+	file.Close();
+	corpus.clear();
+	documentStarts.assign(1, 0);
+	suffixArray.clear();
+	lcpArray.clear();
+	documentCount = 0;
+	built = false;
+	useOwned();
+}
+
+//Starts of a damaged file are clamped to an empty document
+auto	MSubstringIndex::Document(unsigned int id) const -> MStringView
+{
+	if (id >= documentCount || starts[id] >= starts[id + 1] || starts[id + 1] > textSize)
+		return MStringView();
+	return MStringView(text + starts[id], starts[id + 1] - starts[id] - 1);
+}
+
+auto	MSubstringIndex::Count(MStringView pattern) const -> unsigned int
+{
+	unsigned int first;
+	unsigned int last;
+	return range(pattern, first, last) ? last - first : 0;
+}
+
+auto	MSubstringIndex::FindAll(MStringView pattern, std::vector<Match>& matches) const -> unsigned int
+{
+	size_t before = matches.size();
+	Locate(pattern, [&matches](Match const& match)
+	{
+		matches.push_back(match);
+		return true;
+	});
+	std::sort(matches.begin() + before, matches.end(), [](Match const& first, Match const& second)
+	{
+		return first.Document != second.Document ? first.Document < second.Document : first.Offset < second.Offset;
+	});
+	return (unsigned int)(matches.size() - before);
+}
+
+auto	MSubstringIndex::LongestRepeat() const -> MStringView
+{
+	if (!built || textSize == 0)
+		return MStringView();
+	unsigned int best = 0;
+	for (unsigned int idx = 1; idx < textSize; ++idx)
+	{
+		if (lcps[idx] > lcps[best])
+			best = idx;
+	}
+	if (suffixes[best] >= textSize || lcps[best] > textSize - suffixes[best])
+		return MStringView();
+	return MStringView(text + suffixes[best], lcps[best]);
+}
+
+auto	MSubstringIndex::Save(char const* path) const -> bool
+{
+	if (!built)
+		return false;
+#ifdef _WIN32
+	FILE* out = _wfopen(MWString::FromUTF8(path).Str(), L"wb");
+#else
+	FILE* out = fopen(path, "wb");
+#endif
+	if (!out)
+		return false;
+	FileHeader		header = { { 'M', 'S', 'X', 'I' }, Version, textSize, documentCount, {} };
+	char const		padding[4] = {};
+	bool			written = fwrite(&header, sizeof(header), 1, out) == 1
+		&& fwrite(text, 1, textSize, out) == textSize
+		&& fwrite(padding, 1, (4 - textSize % 4) % 4, out) == (4 - textSize % 4) % 4
+		&& fwrite(starts, sizeof(unsigned int), documentCount + 1, out) == documentCount + 1
+		&& fwrite(suffixes, sizeof(unsigned int), textSize, out) == textSize
+		&& fwrite(lcps, sizeof(unsigned int), textSize, out) == textSize;
+	return fclose(out) == 0 && written;
+}
+
+auto	MSubstringIndex::Load(char const* path) -> bool
+{
+	Clear();
+	if (!file.Open(path) || file.Size() < sizeof(FileHeader))
+	{
+		file.Close();
+		return false;
+	}
+	FileHeader header;
+	memcpy(&header, file.Data(), sizeof(header));
+	unsigned long long	textBytes = (header.textSize + 3ull) / 4 * 4;
+	unsigned long long	expected = sizeof(FileHeader) + textBytes + 4ull * (header.documentCount + 1ull + 2ull * header.textSize);
+	if (memcmp(header.magic, "MSXI", 4) != 0 || header.version != Version || file.Size() != expected)
+	{
+		file.Close();
+		return false;
+	}
+	//Mapped views are page aligned, every array lands on a 4 bytes boundary
+	char const* data = file.Data();
+	text = data + sizeof(FileHeader);
+	textSize = header.textSize;
+	documentCount = header.documentCount;
+	starts = (unsigned int const*)(text + textBytes);
+	suffixes = starts + documentCount + 1;
+	lcps = suffixes + textSize;
+
+	//Only the ends are read here, the entries in between are bounded where the queries use them
+	if (starts[0] != 0 || starts[documentCount] != textSize || (textSize && text[textSize - 1] != '\0'))
+	{
+		Clear();
+		return false;
+	}
+	built = true;
+	return true;
+}
+
+auto	MSubstringIndex::Verify() const -> bool
+{
+	bool valid = starts[0] == 0 && starts[documentCount] == textSize;
+	for (unsigned int document = 0; valid && document < documentCount; ++document)
+		valid = starts[document] < starts[document + 1] && text[starts[document + 1] - 1] == '\0';
+	for (unsigned int idx = 0; valid && built && idx < textSize; ++idx)
+		valid = suffixes[idx] < textSize && lcps[idx] <= textSize - suffixes[idx];
+	return valid;
+}
+
+auto	MSubstringIndex::range(MStringView pattern, unsigned int& first, unsigned int& last) const -> bool
+{
+	if (!built || pattern.Count() == 0)
+		return false;
+	first = bound(pattern, false);
+	last = bound(pattern, true);
+	return first < last;
+}
+
+//Binary search keeping the common prefix of the pattern with both ends of the range, the comparison at the middle
+//starts after the smaller one since every suffix between the ends shares it
+auto	MSubstringIndex::bound(MStringView pattern, bool upper) const -> unsigned int
+{
+	char const*		data = pattern.Data();
+	unsigned int	length = pattern.Count();
+	unsigned int	low = 0;
+	unsigned int	high = textSize;
+	unsigned int	lowCommon = 0;
+	unsigned int	highCommon = 0;
+	while (low < high)
+	{
+		unsigned int	middle = low + (high - low) / 2;
+		unsigned int	suffix = suffixes[middle];
+		unsigned int	available = suffix < textSize ? textSize - suffix : 0;
+		unsigned int	common = std::min(std::min(lowCommon, highCommon), available);
+		while (common < length && common < available && text[suffix + common] == data[common])
+			++common;
+		bool before;
+		if (common == length)
+			before = upper;
+		else if (common == available)
+			before = true;
+		else
+			before = (unsigned char)text[suffix + common] < (unsigned char)data[common];
+		if (before)
+		{
+			low = middle + 1;
+			lowCommon = common;
+		}
+		else
+		{
+			high = middle;
+			highCommon = common;
+		}
+	}
+	return low;
+}
+
+auto	MSubstringIndex::documentOf(unsigned int offset) const -> unsigned int
+{
+	return (unsigned int)(std::upper_bound(starts, starts + documentCount + 1, offset) - starts) - 1;
+}
+
+auto	MSubstringIndex::useOwned() -> void
+{
+	if (file.IsOpen())
+	{
+		corpus.assign(text, text + textSize);
+		documentStarts.assign(starts, starts + documentCount + 1);
+		suffixArray.assign(suffixes, suffixes + (built ? textSize : 0));
+		lcpArray.assign(lcps, lcps + (built ? textSize : 0));
+		file.Close();
+	}
+	text = corpus.empty() ? "" : corpus.data();
+	textSize = (unsigned int)corpus.size();
+	starts = documentStarts.data();
+	suffixes = suffixArray.data();
+	lcps = lcpArray.data();
+}
+
+//SA-IS (Nong, Zhang, Chan): suffixes are typed S when smaller than the next one and L otherwise. Sorting the LMS
+//substrings (an S right after an L) by induction names them, the suffixes of the string of names are sorted
+//recursively when names repeat, and the sorted LMS suffixes induce the order of all the others.
+//The sentinel after the last symbol is implicit, it is smaller than every symbol.
+template<class Symbol>
+auto	MSubstringIndex::sais(Symbol const* symbols, unsigned int count, unsigned int alphabet, unsigned int* suffixes) -> void
+{
+	if (count == 0)
+		return;
+	if (count == 1)
+	{
+		suffixes[0] = 0;
+		return;
+	}
+	std::vector<unsigned char>	types(count, 0);
+	for (unsigned int idx = count - 1; idx-- > 0;)
+		types[idx] = symbols[idx] < symbols[idx + 1] || (symbols[idx] == symbols[idx + 1] && types[idx + 1]);
+	auto isLms = [&types](unsigned int idx) { return idx > 0 && types[idx] && !types[idx - 1]; };
+
+	std::vector<unsigned int>	counts(alphabet, 0);
+	std::vector<unsigned int>	bucket(alphabet);
+	for (unsigned int idx = 0; idx < count; ++idx)
+		++counts[symbols[idx]];
+
+	//LMS positions in text order, placed at the end of their buckets to sort the LMS substrings
+	std::vector<unsigned int>	lms;
+	for (unsigned int idx = 1; idx < count; ++idx)
+	{
+		if (isLms(idx))
+			lms.push_back(idx);
+	}
+	unsigned int lmsCount = (unsigned int)lms.size();
+	//Every byte set is Empty
+	memset(suffixes, 0xFF, count * sizeof(unsigned int));
+	for (unsigned int idx = 0, sum = 0; idx < alphabet; ++idx)
+		bucket[idx] = sum += counts[idx];
+	for (unsigned int idx = lmsCount; idx-- > 0;)
+		suffixes[--bucket[symbols[lms[idx]]]] = lms[idx];
+	induce(symbols, count, types.data(), counts.data(), bucket.data(), alphabet, suffixes);
+
+	//Sorted LMS substrings are packed at the start, their names go in the second half at position / 2,
+	//LMS positions being at least 2 apart
+	unsigned int packed = 0;
+	for (unsigned int idx = 0; idx < count; ++idx)
+	{
+		if (isLms(suffixes[idx]))
+			suffixes[packed++] = suffixes[idx];
+	}
+	memset(suffixes + lmsCount, 0xFF, (count - lmsCount) * sizeof(unsigned int));
+	unsigned int names = 0;
+	unsigned int previous = Empty;
+	for (unsigned int idx = 0; idx < lmsCount; ++idx)
+	{
+		unsigned int	current = suffixes[idx];
+		bool			same = previous != Empty;
+		for (unsigned int offset = 0; same; ++offset)
+		{
+			//The substring reaching the sentinel is unique
+			if (current + offset == count || previous + offset == count
+				|| symbols[current + offset] != symbols[previous + offset] || types[current + offset] != types[previous + offset])
+				same = false;
+			else if (offset > 0 && isLms(current + offset))
+				break;
+		}
+		if (!same)
+			++names;
+		previous = current;
+		suffixes[lmsCount + current / 2] = names - 1;
+	}
+
+	std::vector<unsigned int>	reduced(lmsCount);
+	for (unsigned int idx = lmsCount, next = 0; idx < count; ++idx)
+	{
+		if (suffixes[idx] != Empty)
+			reduced[next++] = suffixes[idx];
+	}
+	std::vector<unsigned int>	order(lmsCount);
+	if (names < lmsCount)
+		sais(reduced.data(), lmsCount, names, order.data());
+	else
+	{
+		for (unsigned int idx = 0; idx < lmsCount; ++idx)
+			order[reduced[idx]] = idx;
+	}
+	reduced.clear();
+	reduced.shrink_to_fit();
+
+	memset(suffixes, 0xFF, count * sizeof(unsigned int));
+	for (unsigned int idx = 0, sum = 0; idx < alphabet; ++idx)
+		bucket[idx] = sum += counts[idx];
+	for (unsigned int idx = lmsCount; idx-- > 0;)
+	{
+		unsigned int position = lms[order[idx]];
+		suffixes[--bucket[symbols[position]]] = position;
+	}
+	induce(symbols, count, types.data(), counts.data(), bucket.data(), alphabet, suffixes);
+}
+
+//L suffixes are induced left to right from the bucket starts, then S suffixes right to left from the bucket ends
+template<class Symbol>
+auto	MSubstringIndex::induce(Symbol const* symbols, unsigned int count, unsigned char const* types, unsigned int const* counts, unsigned int* bucket, unsigned int alphabet, unsigned int* suffixes) -> void
+{
+	for (unsigned int idx = 0, sum = 0; idx < alphabet; ++idx)
+	{
+		bucket[idx] = sum;
+		sum += counts[idx];
+	}
+	//The last suffix is L and follows the sentinel
+	suffixes[bucket[symbols[count - 1]]++] = count - 1;
+	for (unsigned int idx = 0; idx < count; ++idx)
+	{
+		unsigned int position = suffixes[idx];
+		if (position != Empty && position > 0 && !types[position - 1])
+			suffixes[bucket[symbols[position - 1]]++] = position - 1;
+	}
+
+	for (unsigned int idx = 0, sum = 0; idx < alphabet; ++idx)
+		bucket[idx] = sum += counts[idx];
+	for (unsigned int idx = count; idx-- > 0;)
+	{
+		unsigned int position = suffixes[idx];
+		if (position != Empty && position > 0 && types[position - 1])
+			suffixes[--bucket[symbols[position - 1]]] = position - 1;
+	}
+}
+
+template<class Work>
+auto	MSubstringIndex::runWorkers(unsigned int workers, Work const& work) -> void
+{
+	std::vector<std::thread> pool;
+	for (unsigned int worker = 1; worker < workers; ++worker)
+		pool.emplace_back([&work, worker]() { work(worker); });
+	work(0);
+	for (std::thread& thread : pool)
+		thread.join();
+}
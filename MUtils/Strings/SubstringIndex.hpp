@@ -0,0 +1,125 @@
+#ifndef __MSUBSTRINGINDEX_HPP__
+#define __MSUBSTRINGINDEX_HPP__
+
+#include <vector>
+
+#include "../String.hpp"
+#include "MappedFile.hpp"
+
+//Suffix array with its LCP array over a set of documents, answering count and locate queries for any substring
+//in O(m log n) without scanning the text. The documents are stored one after the other, each followed by a '\0',
+//so a pattern without '\0' never matches across two of them.
+//Build is O(n) (SA-IS), only the LCP pass is split over threads. A built index can be saved to disk and loaded
+//back by mapping the file, nothing is rebuilt, copied or read before the queries touch it.
+class MSubstringIndex
+{
+public:
+	struct Match
+	{
+		unsigned int	Document;
+		unsigned int	Offset;
+	};
+
+	static const unsigned int	AllThreads = 0;
+
+	MSubstringIndex() = default;
+	MSubstringIndex(MSubstringIndex const&) = delete;
+	auto	operator=(MSubstringIndex const&) -> MSubstringIndex& = delete;
+
+	//Returns the document id, ids are given in order from 0. Adding a document drops the built index, queries find
+	//nothing until Build is called again. The whole text with separators must stay under 4 GB.
+	auto	AddDocument(MStringView text) -> unsigned int;
+	auto	Build(unsigned int threads = 1) -> void;
+	auto	Clear() -> void;
+
+	auto	IsBuilt() const -> bool { return built; }
+	auto	DocumentCount() const -> unsigned int { return documentCount; }
+	auto	Document(unsigned int id) const -> MStringView;
+
+	//Number of occurrences of pattern, overlapping ones included. An empty pattern never matches.
+	auto	Count(MStringView pattern) const -> unsigned int;
+
+	//Calls callback(Match) for every occurrence in suffix order, the scan stops early when callback returns false
+	template<class Callback>
+	auto	Locate(MStringView pattern, Callback&& callback) const -> void;
+
+	//Appends every occurrence to matches sorted by document and offset, returns how many were found
+	auto	FindAll(MStringView pattern, std::vector<Match>& matches) const -> unsigned int;
+
+	//Longest substring found at least twice in the documents, empty when there is none
+	auto	LongestRepeat() const -> MStringView;
+
+	//Paths are UTF-8. The file layout is native endian, Load rejects files written with another one.
+	auto	Save(char const* path) const -> bool;
+	//Replaces the current index, the text and both arrays are used in place from the mapped file. Only the header and
+	//the sizes are checked, queries on a damaged file stay in bounds but their results are wrong until Verify fails.
+	auto	Load(char const* path) -> bool;
+	//Checks every document start, suffix and LCP entry against the text, reading the whole index once
+	auto	Verify() const -> bool;
+
+private:
+	//Written at the start of saved files, followed by the text padded to 4 bytes, the document starts,
+	//the suffix array and the LCP array
+	struct FileHeader
+	{
+		char			magic[4];
+		unsigned int	version;
+		unsigned int	textSize;
+		unsigned int	documentCount;
+		unsigned int	reserved[4];
+	};
+
+	static const unsigned int	Version = 1;
+	static const unsigned int	Empty = 0xFFFFFFFF;
+
+	//Bounds of the suffixes starting with pattern
+	auto	range(MStringView pattern, unsigned int& first, unsigned int& last) const -> bool;
+	//Position of the first suffix not ordered before pattern, prefixes of a suffix count as before when upper is set
+	auto	bound(MStringView pattern, bool upper) const -> unsigned int;
+	auto	documentOf(unsigned int offset) const -> unsigned int;
+	//Points the queries at the vectors, a mapped text is copied first
+	auto	useOwned() -> void;
+
+	template<class Symbol>
+	static auto	sais(Symbol const* symbols, unsigned int count, unsigned int alphabet, unsigned int* suffixes) -> void;
+	template<class Symbol>
+	static auto	induce(Symbol const* symbols, unsigned int count, unsigned char const* types, unsigned int const* counts, unsigned int* bucket, unsigned int alphabet, unsigned int* suffixes) -> void;
+	template<class Work>
+	static auto	runWorkers(unsigned int workers, Work const& work) -> void;
+
+	std::vector<char>			corpus;
+	std::vector<unsigned int>	documentStarts = std::vector<unsigned int>(1, 0);
+	std::vector<unsigned int>	suffixArray;
+	std::vector<unsigned int>	lcpArray;
+	MMappedFile					file;
+
+	//Owned vectors or the mapped file
+	char const*					text = "";
+	unsigned int				textSize = 0;
+	unsigned int const*			starts = documentStarts.data();
+	unsigned int const*			suffixes = nullptr;
+	unsigned int const*			lcps = nullptr;
+	unsigned int				documentCount = 0;
+	bool						built = false;
+};
+
+template<class Callback>
+auto	MSubstringIndex::Locate(MStringView pattern, Callback&& callback) const -> void
+{
+	unsigned int first;
+	unsigned int last;
+	if (!range(pattern, first, last))
+		return;
+	for (unsigned int idx = first; idx < last; ++idx)
+	{
+		//Only a damaged file holds suffixes past the text
+		unsigned int suffix = suffixes[idx];
+		if (suffix >= textSize)
+			continue;
+		unsigned int document = documentOf(suffix);
+		if (!callback(Match{ document, suffix - starts[document] }))
+			return;
+	}
+}
+
+#endif /*__MSUBSTRINGINDEX_HPP__*/
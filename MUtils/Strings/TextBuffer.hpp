@@ -0,0 +1,176 @@
+#ifndef __MTEXTBUFFER_HPP__
+#define __MTEXTBUFFER_HPP__
+
+#include "../String.hpp"
+
+//Text made for editing, stored as a gap buffer: the free space of the buffer sits at the last edit position.
+//An edit moves the gap to its position, so edits close to each other cost O(1) amortized whatever the size
+//of the text, where MString::InsertAt and RemoveAt copy everything after the edit.
+//The content is the chars before the gap followed by the chars after it, see Front and Back.
+class MTextBuffer
+{
+public:
+	static const unsigned int	MinCapacity = 64;
+
+	MTextBuffer() = default;
+	explicit MTextBuffer(MStringView text) { Append(text); }
+	MTextBuffer(MTextBuffer const&) = delete;
+	auto	operator=(MTextBuffer const&) -> MTextBuffer& = delete;
+
+	~MTextBuffer() { delete[] data; }
+
+	auto	Count() const -> unsigned int { return capacity - (gapEnd - gapStart); }
+
+	//Same rules as MString: nothing happens when idx is past the end. text may point into this buffer.
+	auto	InsertAt(unsigned int idx, MStringView text) -> void
+	{
+		if (idx > Count() || text.Count() == 0)
+			return;
+		if (data && text.Data() < data + capacity && text.Data() + text.Count() > data)
+		{
+			MString copy(text);
+			InsertAt(idx, copy);
+			return;
+		}
+		moveGap(idx);
+		reserveGap(text.Count());
+		memcpy(data + gapStart, text.Data(), text.Count());
+		gapStart += text.Count();
+	}
+
+	auto	InsertAt(unsigned int idx, char value) -> void
+	{
+		if (idx > Count())
+			return;
+		moveGap(idx);
+		reserveGap(1);
+		data[gapStart++] = value;
+	}
+
+	//Nothing happens when the range goes past the end
+	auto	RemoveAt(unsigned int idx, unsigned int size) -> void
+	{
+		unsigned int length = Count();
+		if (idx > length || size > length - idx)
+			return;
+		moveGap(idx);
+		gapEnd += size;
+	}
+
+	auto	Append(MStringView text) -> void { InsertAt(Count(), text); }
+	auto	Append(char value) -> void { InsertAt(Count(), value); }
+
+	auto	operator+=(MStringView text) -> MTextBuffer& { Append(text); return *this; }
+	auto	operator+=(char value) -> MTextBuffer& { Append(value); return *this; }
+
+	auto	operator[](unsigned int idx) const -> char { return idx < gapStart ? data[idx] : data[idx + gapEnd - gapStart]; }
+
+	//Keeps the buffer allocated
+	auto	Clear() -> void
+	{
+		gapStart = 0;
+		gapEnd = capacity;
+	}
+
+	//Content before and after the gap, valid until the next edit
+	auto	Front() const -> MStringView { return MStringView(data ? data : "", gapStart); }
+	auto	Back() const -> MStringView { return MStringView(data ? data + gapEnd : "", capacity - gapEnd); }
+
+	//Whole content as one view, the gap is moved to the end first
+	auto	View() -> MStringView
+	{
+		moveGap(Count());
+		return Front();
+	}
+
+	//Copies length chars from idx, clamped to the content
+	auto	Substr(unsigned int idx, unsigned int length = MStringView::Npos) const -> MString
+	{
+		unsigned int count = Count();
+		if (idx > count)
+			idx = count;
+		if (length > count - idx)
+			length = count - idx;
+		MString ret;
+		ret.Reserve(length);
+		if (idx < gapStart)
+			ret.Append(Front().Substr(idx, length));
+		if (idx + length > gapStart)
+		{
+			unsigned int backStart = idx > gapStart ? idx - gapStart : 0;
+			ret.Append(Back().Substr(backStart, idx + length - gapStart - backStart));
+		}
+		return ret;
+	}
+
+	auto	ToString(MStringAllocator* allocator = nullptr) const -> MString
+	{
+		MString ret(allocator);
+		ret.Reserve(Count());
+		ret.Append(Front());
+		ret.Append(Back());
+		return ret;
+	}
+
+	//Writes at most size - 1 chars followed by a terminator, returns the number of chars written
+	auto	CopyTo(char* buffer, unsigned int size) const -> unsigned int
+	{
+		if (size == 0)
+			return 0;
+		unsigned int front = gapStart < size - 1 ? gapStart : size - 1;
+		unsigned int back = Back().Count() < size - 1 - front ? Back().Count() : size - 1 - front;
+		memcpy(buffer, Front().Data(), front);
+		memcpy(buffer + front, Back().Data(), back);
+		buffer[front + back] = '\0';
+		return front + back;
+	}
+
+private:
+	//Moves the chars between the gap and pos to the other side of the gap
+	auto	moveGap(unsigned int pos) -> void
+	{
+		if (pos < gapStart)
+		{
+			unsigned int moved = gapStart - pos;
+			memmove(data + gapEnd - moved, data + pos, moved);
+			gapStart -= moved;
+			gapEnd -= moved;
+		}
+		else if (pos > gapStart)
+		{
+			unsigned int moved = pos - gapStart;
+			memmove(data + gapStart, data + gapEnd, moved);
+			gapStart += moved;
+			gapEnd += moved;
+		}
+	}
+
+	//Grows the buffer geometrically when the gap is shorter than size
+	auto	reserveGap(unsigned int size) -> void
+	{
+		if (gapEnd - gapStart >= size)
+			return;
+		unsigned int	back = capacity - gapEnd;
+		unsigned int	needed = capacity - (gapEnd - gapStart) + size;
+		unsigned int	newCapacity = capacity * 2 > needed ? capacity * 2 : needed;
+		if (newCapacity < MinCapacity)
+			newCapacity = MinCapacity;
+		char*			newData = new char[newCapacity];
+		if (data)
+		{
+			memcpy(newData, data, gapStart);
+			memcpy(newData + newCapacity - back, data + gapEnd, back);
+			delete[] data;
+		}
+		data = newData;
+		capacity = newCapacity;
+		gapEnd = newCapacity - back;
+	}
+
+	char*			data = nullptr;
+	unsigned int	capacity = 0;
+	unsigned int	gapStart = 0;
+	unsigned int	gapEnd = 0;
+};
+
+#endif /*__MTEXTBUFFER_HPP__*/
@@ -0,0 +1,204 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+
+#include <cstdlib>
+
+#include "Strings/Glob.hpp"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace MUtilsTest
+{
+	TEST_CLASS(MGlobTest)
+	{
+	public:
+		TEST_METHOD(DoubleStarMatchesDirectories)
+		{
+			MGlob glob("textures/**/diffuse_?.png");
+			Assert::IsTrue(glob.Match("textures/diffuse_a.png"));
+			Assert::IsTrue(glob.Match("textures/a/b/diffuse_1.png"));
+			Assert::IsFalse(glob.Match("textures/a/b/diffuse_12.png"));
+			Assert::IsFalse(glob.Match("texturesdiffuse_a.png"));
+			Assert::IsFalse(glob.Match("textures/diffuse_/.png"));
+
+			Assert::IsTrue(MGlob("**/*.mesh").Match("x.mesh"));
+			Assert::IsTrue(MGlob("**/*.mesh").Match("a/b/x.mesh"));
+			Assert::IsTrue(MGlob("**").Match("a/b/c"));
+			Assert::IsTrue(MGlob("a**b").Match("a/x/b"));
+			Assert::IsTrue(MGlob("a/**").Match("a/"));
+			Assert::IsFalse(MGlob("a/**/b").Match("ab"));
+		}
+
+		TEST_METHOD(SingleWildcardsStopAtSlash)
+		{
+			Assert::IsTrue(MGlob("*.mesh").Match("x.mesh"));
+			Assert::IsFalse(MGlob("*.mesh").Match("a/x.mesh"));
+			Assert::IsTrue(MGlob("*").Match(""));
+			Assert::IsFalse(MGlob("?").Match("/"));
+			Assert::IsTrue(MGlob("").Match(""));
+			Assert::IsFalse(MGlob("").Match("a"));
+		}
+
+		TEST_METHOD(Classes)
+		{
+			Assert::IsTrue(MGlob("[a-c]x").Match("bx"));
+			Assert::IsFalse(MGlob("[!a-c]x").Match("bx"));
+			Assert::IsTrue(MGlob("[^a-c]x").Match("dx"));
+			Assert::IsFalse(MGlob("[^a-c]x").Match("/x"));
+			Assert::IsTrue(MGlob("[]]").Match("]"));
+			Assert::IsTrue(MGlob("[a-]").Match("-"));
+			Assert::IsTrue(MGlob("[ab").Match("[ab"));
+		}
+
+		TEST_METHOD(MatchesReferenceMatcher)
+		{
+			srand(22);
+			for (unsigned int round = 0; round < 50000; ++round)
+			{
+				std::string pattern = randomText("ab/*?[]!-.", rand() % 9);
+				std::string path = randomText("ab/.-", rand() % 10);
+				Assert::AreEqual(reference(pattern, 0, path, 0), MGlob(MStringView(pattern)).Match(MStringView(path)));
+			}
+		}
+
+		TEST_METHOD(SetReportsRulesInOrder)
+		{
+			MGlobSet set;
+			Assert::AreEqual(0u, set.Add("*.mesh"));
+			set.Add("**");
+			set.Add("textures/**/diffuse_?.png");
+			set.Add("**/*.png");
+			set.Add("*.mesh");
+			for (unsigned int pass = 0; pass < 2; ++pass)
+			{
+				std::vector<unsigned int> ids;
+				Assert::AreEqual(3u, set.FindAll("textures/x/diffuse_a.png", ids));
+				Assert::IsTrue(ids[0] == 1 && ids[1] == 2 && ids[2] == 3);
+				ids.clear();
+				Assert::AreEqual(3u, set.FindAll("a.mesh", ids));
+				Assert::IsTrue(ids[0] == 0 && ids[1] == 1 && ids[2] == 4);
+				Assert::AreEqual(0u, set.FirstMatch("a.mesh"));
+				Assert::IsTrue(set.Build());
+			}
+			set.Add("a*b");
+			Assert::IsFalse(set.IsBuilt());
+			std::vector<unsigned int> ids;
+			Assert::AreEqual(2u, set.FindAll("ab", ids));
+			Assert::AreEqual(5u, ids[1]);
+			MGlobSet none;
+			none.Add("*.x");
+			Assert::IsFalse(none.MatchesAny("a.y"));
+			Assert::IsTrue(none.FirstMatch("") == MGlobSet::NoMatch);
+		}
+
+		TEST_METHOD(SetMatchesEveryRule)
+		{
+			srand(23);
+			for (unsigned int round = 0; round < 500; ++round)
+			{
+				MGlobSet			set;
+				std::vector<MGlob>	globs;
+				unsigned int		rules = 1 + rand() % (round % 10 == 0 ? 200 : 12);
+				for (unsigned int idx = 0; idx < rules; ++idx)
+				{
+					std::string pattern = randomText("ab/*?[]!-.", rand() % 9);
+					set.Add(MStringView(pattern));
+					globs.push_back(MGlob(MStringView(pattern)));
+				}
+				if (round % 2)
+					set.Build();
+				for (unsigned int query = 0; query < 20; ++query)
+				{
+					std::string					path = randomText("ab/.-", rand() % 10);
+					std::vector<unsigned int>	found;
+					std::vector<unsigned int>	expected;
+					set.FindAll(MStringView(path), found);
+					for (unsigned int idx = 0; idx < rules; ++idx)
+					{
+						if (globs[idx].Match(MStringView(path)))
+							expected.push_back(idx);
+					}
+					Assert::IsTrue(found == expected);
+				}
+			}
+		}
+
+	private:
+		static auto	randomText(char const* alphabet, unsigned int length) -> std::string
+		{
+			std::string text;
+			for (unsigned int idx = 0; idx < length; ++idx)
+				text += alphabet[rand() % strlen(alphabet)];
+			return text;
+		}
+
+		//Backtracking matcher following the rules of the MGlob comment
+		static auto	reference(std::string const& pattern, size_t pos, std::string const& path, size_t at) -> bool
+		{
+			if (pos == pattern.size())
+				return at == path.size();
+			char c = pattern[pos];
+			if (c == '*')
+			{
+				size_t end = pos;
+				while (end < pattern.size() && pattern[end] == '*')
+					++end;
+				if (end - pos == 1)
+				{
+					for (size_t next = at; ; ++next)
+					{
+						if (reference(pattern, end, path, next))
+							return true;
+						if (next == path.size() || path[next] == '/')
+							return false;
+					}
+				}
+				if ((pos == 0 || pattern[pos - 1] == '/') && end < pattern.size() && pattern[end] == '/')
+				{
+					if (reference(pattern, end + 1, path, at))
+						return true;
+					for (size_t next = at; next < path.size(); ++next)
+					{
+						if (path[next] == '/' && reference(pattern, end + 1, path, next + 1))
+							return true;
+					}
+					return false;
+				}
+				for (size_t next = at; next <= path.size(); ++next)
+				{
+					if (reference(pattern, end, path, next))
+						return true;
+				}
+				return false;
+			}
+			if (c == '?')
+				return at < path.size() && path[at] != '/' && reference(pattern, pos + 1, path, at + 1);
+			if (c == '[')
+			{
+				size_t	idx = pos + 1;
+				bool	negated = idx < pattern.size() && (pattern[idx] == '!' || pattern[idx] == '^');
+				bool	inside = false;
+				if (negated)
+					++idx;
+				for (bool first = true; idx < pattern.size() && (first || pattern[idx] != ']'); first = false)
+				{
+					unsigned char low = pattern[idx];
+					unsigned char high = low;
+					if (idx + 2 < pattern.size() && pattern[idx + 1] == '-' && pattern[idx + 2] != ']')
+					{
+						high = pattern[idx + 2];
+						idx += 3;
+					}
+					else
+						++idx;
+					if (at < path.size() && (unsigned char)path[at] >= low && (unsigned char)path[at] <= high)
+						inside = true;
+				}
+				//An unclosed class is a literal '['
+				if (idx < pattern.size())
+					return at < path.size() && path[at] != '/' && inside != negated && reference(pattern, idx + 1, path, at + 1);
+			}
+			return at < path.size() && path[at] == c && reference(pattern, pos + 1, path, at + 1);
+		}
+	};
+}
@@ -0,0 +1,118 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+
+#include <cstdio>
+#include <fstream>
+
+#include "Strings/MappedFile.hpp"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace MUtilsTest
+{
+	TEST_CLASS(MMappedFileTest)
+	{
+	public:
+		TEST_METHOD(LinesDropCarriageReturns)
+		{
+			std::vector<MStringView> lines = split("first\r\n\r\nthird\rstill third\nlast");
+			Assert::AreEqual((size_t)4, lines.size());
+			Assert::IsTrue(lines[0] == "first");
+			Assert::IsTrue(lines[1] == "");
+			Assert::IsTrue(lines[2] == "third\rstill third");
+			Assert::IsTrue(lines[3] == "last");
+		}
+
+		TEST_METHOD(LinesAtEdges)
+		{
+			Assert::AreEqual((size_t)0, split("").size());
+			Assert::AreEqual((size_t)1, split("\n").size());
+			Assert::AreEqual((size_t)1, split("no newline").size());
+			Assert::AreEqual((size_t)2, split("a\n\n").size());
+			Assert::IsTrue(split("\r\n")[0].IsEmpty());
+		}
+
+		TEST_METHOD(LongLinesCrossBlocks)
+		{
+			std::string text;
+			for (unsigned int length = 0; length < 80; ++length)
+				text += std::string(length, 'x') + "\n";
+			std::vector<MStringView> lines = split(text.c_str());
+			Assert::AreEqual((size_t)80, lines.size());
+			for (unsigned int length = 0; length < 80; ++length)
+				Assert::AreEqual(length, lines[length].Count());
+		}
+
+		TEST_METHOD(MapsWholeFile)
+		{
+			std::string content = writeFile("MMappedFileTest.txt", 10000);
+			{
+				MMappedFile file("MMappedFileTest.txt");
+				Assert::IsTrue(file.IsOpen());
+				Assert::AreEqual((unsigned long long)content.size(), file.Size());
+				Assert::IsTrue(file.View() == MStringView(content));
+				unsigned int count = 0;
+				for (MStringView line : file.Lines())
+				{
+					Assert::IsTrue(line == MString::Format(MFORMAT("line {}"), count));
+					++count;
+				}
+				Assert::AreEqual(10000u, count);
+			}
+			std::remove("MMappedFileTest.txt");
+		}
+
+		TEST_METHOD(EmptyAndMissingFiles)
+		{
+			writeFile("MMappedFileEmpty.txt", 0);
+			MMappedFile file;
+			Assert::IsTrue(file.Open("MMappedFileEmpty.txt"));
+			Assert::AreEqual(0ull, file.Size());
+			Assert::IsTrue(file.Lines().begin() == file.Lines().end());
+			file.Close();
+			Assert::IsFalse(file.IsOpen());
+			std::remove("MMappedFileEmpty.txt");
+
+			Assert::IsFalse(file.Open("MMappedFileMissing.txt"));
+			MString content("unchanged");
+			Assert::IsFalse(MMappedFile::ReadAll("MMappedFileMissing.txt", content));
+		}
+
+		TEST_METHOD(ReadAllReusesString)
+		{
+			std::string content = writeFile("MMappedFileRead.txt", 2);
+			MString		read;
+			read.Reserve(1000);
+			Assert::IsTrue(MMappedFile::ReadAll("MMappedFileRead.txt", read));
+			Assert::IsTrue(read == MStringView(content));
+			Assert::AreEqual(1000u, read.Capacity());
+
+			MString shared("a string that does not fit inside the object");
+			MString copy(shared);
+			Assert::IsTrue(MMappedFile::ReadAll("MMappedFileRead.txt", copy));
+			Assert::IsTrue(copy == MStringView(content));
+			Assert::AreEqual("a string that does not fit inside the object", shared.Str());
+			std::remove("MMappedFileRead.txt");
+		}
+
+	private:
+		static auto	split(char const* text) -> std::vector<MStringView>
+		{
+			std::vector<MStringView> lines;
+			for (MStringView line : MStringLines(MStringView(text)))
+				lines.push_back(line);
+			return lines;
+		}
+
+		//Writes lineCount lines "line <n>" with alternating line endings and returns the content
+		static auto	writeFile(char const* path, unsigned int lineCount) -> std::string
+		{
+			std::string content;
+			for (unsigned int idx = 0; idx < lineCount; ++idx)
+				content += "line " + std::to_string(idx) + (idx % 2 ? "\r\n" : "\n");
+			std::ofstream out(path, std::ios::binary);
+			out << content;
+			return content;
+		}
+	};
+}
@@ -0,0 +1,232 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+
+#include <cstdlib>
+#include <map>
+
+#include "Strings/RadixTrie.hpp"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace MUtilsTest
+{
+	TEST_CLASS(MRadixTrieTest)
+	{
+	public:
+		TEST_METHOD(EmptyKeyAndPrefixKeys)
+		{
+			MRadixTrie<int> trie;
+			Assert::IsTrue(trie.Find("") == nullptr);
+			Assert::IsTrue(trie.Insert("", 1));
+			Assert::IsTrue(trie.Insert("ab", 2));
+			Assert::IsTrue(trie.Insert("abcd", 3));
+			Assert::IsTrue(trie.Insert("a", 4));
+			Assert::IsFalse(trie.Insert("ab", 5));
+			Assert::AreEqual(4u, trie.Count());
+			Assert::AreEqual(1, *trie.Find(""));
+			Assert::AreEqual(5, *trie.Find("ab"));
+			Assert::IsTrue(trie.Find("abc") == nullptr);
+			Assert::IsFalse(trie.Contains("abcde"));
+
+			unsigned int length = 0;
+			Assert::AreEqual(3, *trie.LongestPrefix("abcdef", &length));
+			Assert::AreEqual(4u, length);
+			Assert::AreEqual(5, *trie.LongestPrefix("abc", &length));
+			Assert::AreEqual(2u, length);
+			Assert::AreEqual(1, *trie.LongestPrefix("xyz", &length));
+			Assert::AreEqual(0u, length);
+
+			Assert::IsTrue(trie.Remove(""));
+			Assert::IsFalse(trie.Remove(""));
+			Assert::IsFalse(trie.Remove("abc"));
+			Assert::IsTrue(trie.LongestPrefix("xyz") == nullptr);
+			Assert::AreEqual(4, *trie.LongestPrefix("ax"));
+		}
+
+		TEST_METHOD(MatchesMapUnderRandomEdits)
+		{
+			srand(24);
+			MRadixTrie<unsigned int>				trie;
+			std::map<std::string, unsigned int>		expected;
+			unsigned long long						emptyMemory = trie.MemoryUsage();
+			for (unsigned int round = 0; round < 20000; ++round)
+			{
+				std::string key = randomKey(round);
+				if (rand() % 3)
+				{
+					Assert::AreEqual(expected.count(key) == 0, trie.Insert(MStringView(key), round));
+					expected[key] = round;
+				}
+				else
+					Assert::AreEqual(expected.erase(key) == 1, trie.Remove(MStringView(key)));
+				Assert::AreEqual((unsigned int)expected.size(), trie.Count());
+
+				std::string				probe = randomKey(round);
+				auto					found = expected.find(probe);
+				unsigned int const*		value = trie.Find(MStringView(probe));
+				Assert::IsTrue(found == expected.end() ? value == nullptr : value && *value == found->second);
+				if (round % 97 == 0)
+					checkContents(trie, expected);
+			}
+			checkContents(trie, expected);
+
+			//Removing every key gives all the node memory back
+			for (auto const& entry : expected)
+				Assert::IsTrue(trie.Remove(MStringView(entry.first)));
+			Assert::AreEqual(0u, trie.Count());
+			Assert::AreEqual(1u, trie.NodeCount());
+			Assert::IsTrue(emptyMemory == trie.MemoryUsage());
+		}
+
+		TEST_METHOD(NodesShrinkWithTheirChildren)
+		{
+			MRadixTrie<int> trie;
+			fillBranches(trie, 256);
+			//Each size class is left once the children fit the smaller one with room to spare,
+			//the node then takes as much memory as one built with the remaining children
+			for (unsigned int c = 255; c > 0; --c)
+			{
+				char key[3] = { 'p', (char)c, 'x' };
+				Assert::IsTrue(trie.Remove(MStringView(key, 3)));
+				for (unsigned int left = 0; left < c; left += 17)
+				{
+					char kept[3] = { 'p', (char)left, 'x' };
+					Assert::AreEqual((int)left, *trie.Find(MStringView(kept, 3)));
+				}
+				if (c == 37 || c == 12 || c == 3 || c == 1)
+				{
+					MRadixTrie<int> built;
+					fillBranches(built, c);
+					Assert::IsTrue(built.MemoryUsage() == trie.MemoryUsage());
+					Assert::AreEqual(built.NodeCount(), trie.NodeCount());
+				}
+			}
+		}
+
+		TEST_METHOD(LongestPrefixMatchesMap)
+		{
+			srand(25);
+			MRadixTrie<unsigned int>				trie;
+			std::map<std::string, unsigned int>		expected;
+			for (unsigned int idx = 0; idx < 300; ++idx)
+			{
+				std::string key = randomKey(idx);
+				expected[key] = idx;
+				trie.Insert(MStringView(key), idx);
+			}
+			for (unsigned int round = 0; round < 2000; ++round)
+			{
+				std::string		text = randomKey(round) + randomKey(round + 1);
+				unsigned int	bestLength = 0;
+				bool			found = false;
+				for (unsigned int length = 0; length <= text.size(); ++length)
+				{
+					if (expected.count(text.substr(0, length)))
+					{
+						bestLength = length;
+						found = true;
+					}
+				}
+				unsigned int		length = 0xFFFFFFFF;
+				unsigned int const*	value = trie.LongestPrefix(MStringView(text), &length);
+				Assert::AreEqual(found, value != nullptr);
+				if (found)
+				{
+					Assert::AreEqual(bestLength, length);
+					Assert::AreEqual(expected[text.substr(0, bestLength)], *value);
+				}
+			}
+		}
+
+		TEST_METHOD(PrefixedEnumeration)
+		{
+			MRadixTrie<int> trie;
+			char const* keys[] = { "car", "cart", "carbon", "care", "cat", "c", "dog", "" };
+			for (char const* key : keys)
+				trie.Insert(key, 0);
+			std::vector<std::string> found;
+			trie.ForEachPrefixed("car", [&found](MStringView key, int) { found.push_back(std::string(key.Data(), key.Count())); return true; });
+			Assert::IsTrue(found == std::vector<std::string>{ "car", "carbon", "care", "cart" });
+
+			found.clear();
+			trie.ForEachPrefixed("ca", [&found](MStringView key, int) { found.push_back(std::string(key.Data(), key.Count())); return found.size() < 2; });
+			Assert::IsTrue(found == std::vector<std::string>{ "car", "carbon" });
+
+			found.clear();
+			trie.ForEachPrefixed("cb", [&found](MStringView key, int) { found.push_back(std::string(key.Data(), key.Count())); return true; });
+			Assert::IsTrue(found.empty());
+		}
+
+		TEST_METHOD(WideNodesShrinkBack)
+		{
+			MRadixTrie<int>		trie;
+			unsigned int		emptyNodes = trie.NodeCount();
+			unsigned long long	emptyMemory = trie.MemoryUsage();
+			for (unsigned int c = 0; c < 256; ++c)
+			{
+				char key[2] = { 'k', (char)c };
+				Assert::IsTrue(trie.Insert(MStringView(key, 2), (int)c));
+			}
+			for (unsigned int c = 0; c < 256; ++c)
+			{
+				char key[2] = { 'k', (char)c };
+				Assert::AreEqual((int)c, *trie.Find(MStringView(key, 2)));
+			}
+			unsigned long long fullMemory = trie.MemoryUsage();
+			int previous = -1;
+			trie.ForEach([&previous](MStringView, int value) { Assert::IsTrue(value == previous + 1); previous = value; return true; });
+			Assert::AreEqual(255, previous);
+
+			for (unsigned int c = 0; c < 256; ++c)
+			{
+				char key[2] = { 'k', (char)c };
+				Assert::IsTrue(trie.Remove(MStringView(key, 2)));
+			}
+			Assert::AreEqual(0u, trie.Count());
+			Assert::AreEqual(emptyNodes, trie.NodeCount());
+			//The root shrank back down to a leaf
+			Assert::IsTrue(trie.MemoryUsage() < fullMemory);
+			Assert::IsTrue(emptyMemory == trie.MemoryUsage());
+			trie.Insert("x", 1);
+			trie.Clear();
+			Assert::IsFalse(trie.Contains("x"));
+			Assert::AreEqual(emptyNodes, trie.NodeCount());
+			Assert::IsTrue(emptyMemory == trie.MemoryUsage());
+		}
+
+	private:
+		//Keys "p" + byte + "x" for the first count bytes, and "q" so the branching node is not the root
+		static auto	fillBranches(MRadixTrie<int>& trie, unsigned int count) -> void
+		{
+			for (unsigned int c = 0; c < count; ++c)
+			{
+				char key[3] = { 'p', (char)c, 'x' };
+				trie.Insert(MStringView(key, 3), (int)c);
+			}
+			trie.Insert("q", 0);
+		}
+
+		//Short keys over a small alphabet so many share prefixes, with a few wide branching bytes
+		static auto	randomKey(unsigned int round) -> std::string
+		{
+			std::string key;
+			for (unsigned int length = rand() % 7; key.size() < length; )
+				key += round % 5 ? "abc"[rand() % 3] : (char)(rand() % 256);
+			return key;
+		}
+
+		static auto	checkContents(MRadixTrie<unsigned int> const& trie, std::map<std::string, unsigned int> const& expected) -> void
+		{
+			auto it = expected.begin();
+			trie.ForEach([&it, &expected](MStringView key, unsigned int value)
+			{
+				Assert::IsTrue(it != expected.end());
+				Assert::IsTrue(key == MStringView(it->first));
+				Assert::AreEqual(it->second, value);
+				++it;
+				return true;
+			});
+			Assert::IsTrue(it == expected.end());
+		}
+	};
+}
@@ -0,0 +1,114 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+
+#include <map>
+
+#include "String.hpp"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace MUtilsTest
+{
+	//Heap allocator checking that every buffer is given back with the size it was allocated with
+	class CheckedAllocator : public MStringAllocator
+	{
+	public:
+		auto	Allocate(unsigned int size) -> char* override
+		{
+			char* ptr = new char[size];
+			live[ptr] = size;
+			++allocations;
+			return ptr;
+		}
+
+		auto	Deallocate(char* ptr, unsigned int size) -> void override
+		{
+			Assert::IsTrue(live.count(ptr) == 1 && live[ptr] == size);
+			live.erase(ptr);
+			delete[] ptr;
+		}
+
+		std::map<char*, unsigned int>	live;
+		unsigned int					allocations = 0;
+	};
+
+	TEST_CLASS(MStringAllocatorTest)
+	{
+	public:
+		TEST_METHOD(BuffersComeFromAllocator)
+		{
+			CheckedAllocator allocator;
+			{
+				MString str(MStringView("a string that does not fit inside the object"), &allocator);
+				Assert::IsTrue(str.GetAllocator() == &allocator);
+				Assert::AreEqual((size_t)1, allocator.live.size());
+				for (unsigned int idx = 0; idx < 200; ++idx)
+					str += 'x';
+				str.ShrinkToFit();
+				str.Empty();
+				MString shortStr(MStringView("short"), &allocator);
+				Assert::IsTrue(shortStr.IsLocal());
+			}
+			Assert::IsTrue(allocator.live.empty());
+		}
+
+		TEST_METHOD(CopiesGoToHeapAssignmentsKeepAllocator)
+		{
+			MStringArena	arena;
+			MString			scratch(MStringView("a string that does not fit inside the object"), &arena);
+			MString			copy(scratch);
+			Assert::IsTrue(copy.GetAllocator() == nullptr);
+			Assert::AreEqual(scratch.Str(), copy.Str());
+
+			MString target(&arena);
+			target = copy;
+			Assert::IsTrue(target.GetAllocator() == &arena);
+			target = std::move(copy);
+			Assert::IsTrue(target.GetAllocator() == &arena);
+			Assert::AreEqual("a string that does not fit inside the object", target.Str());
+
+			MString heap;
+			heap = std::move(target);
+			Assert::IsTrue(heap.GetAllocator() == nullptr);
+			Assert::AreEqual("a string that does not fit inside the object", heap.Str());
+		}
+
+		TEST_METHOD(ArenaGrowsLastStringInPlace)
+		{
+			MStringArena	arena;
+			MString			str(MStringView("a string that does not fit inside the object"), &arena);
+			char const*		buffer = str.Str();
+			for (unsigned int idx = 0; idx < 1000; ++idx)
+				str += 'x';
+			Assert::IsTrue(str.Str() == buffer);
+			Assert::AreEqual((unsigned long long)str.Capacity() + 1, arena.UsedBytes());
+		}
+
+		TEST_METHOD(ArenaGivesBackLastBuffer)
+		{
+			MStringArena arena;
+			{
+				MString first(MStringView("a first string that does not fit inside"), &arena);
+				{
+					MString second(MStringView("a second string that does not fit inside"), &arena);
+				}
+				Assert::AreEqual((unsigned long long)first.Capacity() + 1, arena.UsedBytes());
+			}
+			Assert::AreEqual(0ull, arena.UsedBytes());
+		}
+
+		TEST_METHOD(ArenaResetMergesBlocks)
+		{
+			MStringArena arena(256);
+			for (unsigned int idx = 0; idx < 20; ++idx)
+				arena.Allocate(100);
+			arena.Reset();
+			Assert::AreEqual(0ull, arena.UsedBytes());
+			char* first = arena.Allocate(100);
+			for (unsigned int idx = 1; idx < 20; ++idx)
+				Assert::IsTrue(arena.Allocate(100) == first + idx * 100);
+			char* large = arena.Allocate(100000);
+			memset(large, 0, 100000);
+		}
+	};
+}
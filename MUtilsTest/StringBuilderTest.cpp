@@ -0,0 +1,86 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+
+#include "Strings/StringBuilder.hpp"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace MUtilsTest
+{
+	TEST_CLASS(MStringBuilderTest)
+	{
+	public:
+		TEST_METHOD(EmptyBuilder)
+		{
+			MStringBuilder builder;
+			Assert::AreEqual(0u, builder.Count());
+			Assert::AreEqual("", builder.ToString().Str());
+			char buffer[4] = "xyz";
+			Assert::AreEqual(0u, builder.CopyTo(buffer, sizeof(buffer)));
+			Assert::IsTrue(MStringView(buffer) == "");
+		}
+
+		TEST_METHOD(AppendsSpanChunks)
+		{
+			MStringBuilder	builder;
+			std::string		expected;
+			for (unsigned int idx = 0; idx < 2000; ++idx)
+			{
+				builder.Append("chunk").Append(char('a' + idx % 26));
+				builder.AppendUInt(idx);
+				expected += "chunk";
+				expected += char('a' + idx % 26);
+				expected += std::to_string(idx);
+			}
+			MString str = builder.ToString();
+			Assert::AreEqual((unsigned int)expected.size(), builder.Count());
+			Assert::AreEqual(expected.c_str(), str.Str());
+			Assert::AreEqual(str.Count(), str.Capacity());
+		}
+
+		TEST_METHOD(LargeAppendInOneChunk)
+		{
+			MStringBuilder	builder;
+			std::string		large(1000, 'z');
+			builder.Append("head");
+			builder.Append(MStringView(large));
+			Assert::AreEqual(("head" + large).c_str(), builder.ToString().Str());
+		}
+
+		TEST_METHOD(ClearReusesChunks)
+		{
+			MStringBuilder builder;
+			for (unsigned int idx = 0; idx < 100; ++idx)
+				builder.Append("0123456789");
+			builder.Clear();
+			Assert::AreEqual(0u, builder.Count());
+			builder.Append("again");
+			for (unsigned int idx = 0; idx < 60; ++idx)
+				builder.Append("0123456789");
+			MString str = builder.ToString();
+			Assert::AreEqual(605u, str.Count());
+			Assert::IsTrue(MStringView(str).StartsWith("again0123"));
+			Assert::IsTrue(MStringView(str).EndsWith("89"));
+		}
+
+		TEST_METHOD(CopyToTruncates)
+		{
+			MStringBuilder builder;
+			builder.Append("abcdef");
+			char buffer[4];
+			Assert::AreEqual(3u, builder.CopyTo(buffer, sizeof(buffer)));
+			Assert::IsTrue(MStringView(buffer) == "abc");
+			Assert::AreEqual(0u, builder.CopyTo(buffer, 0));
+		}
+
+		TEST_METHOD(AppendFormatAcrossChunkEnd)
+		{
+			MStringBuilder builder;
+			std::string filler(250, '.');
+			builder.Append(MStringView(filler));
+			builder.AppendFormat(MFORMAT("{} = {}"), "value", 123456789);
+			builder.AppendInt(-5).AppendFloat(0.5f);
+			Assert::AreEqual((filler + "value = 123456789-50.5").c_str(), builder.ToString().Str());
+		}
+	};
+}
@@ -0,0 +1,101 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+
+#include <cstdlib>
+
+#include "String.hpp"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace MUtilsTest
+{
+	TEST_CLASS(MStringCaseTest)
+	{
+	public:
+		TEST_METHOD(OnlyAsciiLettersChange)
+		{
+			char bytes[256];
+			for (unsigned int idx = 0; idx < 256; ++idx)
+				bytes[idx] = (char)idx;
+			MString lower(MStringView(bytes, 256));
+			MString upper(lower);
+			lower.ToLowerInPlace();
+			upper.ToUpperInPlace();
+			for (unsigned int idx = 0; idx < 256; ++idx)
+			{
+				Assert::AreEqual(idx >= 'A' && idx <= 'Z' ? (char)(idx + 32) : (char)idx, lower[idx]);
+				Assert::AreEqual(idx >= 'a' && idx <= 'z' ? (char)(idx - 32) : (char)idx, upper[idx]);
+			}
+		}
+
+		TEST_METHOD(ToLowerReturnsCopy)
+		{
+			MString str("Mixed Case String Longer Than The Local Buffer");
+			MString lower = str.ToLower();
+			Assert::AreEqual("mixed case string longer than the local buffer", lower.Str());
+			Assert::AreEqual("MIXED CASE STRING LONGER THAN THE LOCAL BUFFER", str.ToUpper().Str());
+			Assert::AreEqual("Mixed Case String Longer Than The Local Buffer", str.Str());
+		}
+
+		TEST_METHOD(CompareMatchesLoweredCompare)
+		{
+			srand(7);
+			for (unsigned int round = 0; round < 3000; ++round)
+			{
+				std::string first = randomText(rand() % 40);
+				std::string second = rand() % 3 ? flipCase(first) : randomText(rand() % 40);
+				if (rand() % 4 == 0 && !second.empty())
+					second.pop_back();
+				int expected = lowered(first).compare(lowered(second));
+				int result = MStringView(first).CompareIgnoreCase(MStringView(second));
+				Assert::IsTrue((expected < 0) == (result < 0) && (expected > 0) == (result > 0));
+				Assert::AreEqual(expected == 0, MStringView(first).EqualsIgnoreCase(MStringView(second)));
+			}
+		}
+
+		TEST_METHOD(FindIgnoreCaseMatchesNaiveSearch)
+		{
+			srand(8);
+			for (unsigned int round = 0; round < 2000; ++round)
+			{
+				std::string hay = randomText(rand() % 70);
+				std::string needle = flipCase(randomText(1 + rand() % 3));
+				size_t expected = lowered(hay).find(lowered(needle));
+				unsigned int found = MStringView(hay).FindIgnoreCase(MStringView(needle));
+				Assert::IsTrue(expected == std::string::npos ? found == MStringView::Npos : found == (unsigned int)expected);
+			}
+			Assert::IsTrue(MString("Texture.PNG").ContainsIgnoreCase(".png"));
+			Assert::IsFalse(MString("[").EqualsIgnoreCase("{"));
+			Assert::IsFalse(MString("@").EqualsIgnoreCase("`"));
+		}
+
+	private:
+		static auto	randomText(unsigned int length) -> std::string
+		{
+			std::string text;
+			for (unsigned int idx = 0; idx < length; ++idx)
+				text += "aBz@[`{\xc9\xe9"[rand() % 9];
+			return text;
+		}
+
+		static auto	flipCase(std::string text) -> std::string
+		{
+			for (char& c : text)
+			{
+				if (rand() % 2 && ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z')))
+					c ^= 0x20;
+			}
+			return text;
+		}
+
+		static auto	lowered(std::string text) -> std::string
+		{
+			for (char& c : text)
+			{
+				if (c >= 'A' && c <= 'Z')
+					c += 32;
+			}
+			return text;
+		}
+	};
+}
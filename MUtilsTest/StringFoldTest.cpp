@@ -0,0 +1,77 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+
+#include <unordered_set>
+
+#include "String.hpp"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace MUtilsTest
+{
+	TEST_CLASS(MStringFoldTest)
+	{
+	public:
+		TEST_METHOD(FoldsSingleCodePoints)
+		{
+			Assert::AreEqual(0xE9u, MStringFold::Fold(0xC9));
+			Assert::AreEqual(0x3C3u, MStringFold::Fold(0x3A3));
+			Assert::AreEqual(0x3C3u, MStringFold::Fold(0x3C2));
+			Assert::AreEqual((unsigned int)'k', MStringFold::Fold(0x212A));
+			Assert::AreEqual(0xDFu, MStringFold::Fold(0x1E9E));
+			Assert::AreEqual(0x1E922u, MStringFold::Fold(0x1E900));
+			Assert::AreEqual(0x4E00u, MStringFold::Fold(0x4E00));
+			Assert::AreEqual((unsigned int)'a', MStringFold::Fold('A'));
+		}
+
+		TEST_METHOD(FoldCanChangeEncodedLength)
+		{
+			MString kelvin("\xE2\x84\xAA");
+			Assert::AreEqual("k", kelvin.FoldCase().Str());
+			MString barred("\xC8\xBA");
+			Assert::AreEqual("\xE2\xB1\xA5", barred.FoldCase().Str());
+			MString mixed("Stra\xE1\xBA\x9E" "E \xCE\xA3\xCE\xA9\xCE\xA3 \xE2\x84\xAA");
+			Assert::AreEqual("stra\xC3\x9F" "e \xCF\x83\xCF\x89\xCF\x83 k", mixed.FoldCase().Str());
+		}
+
+		TEST_METHOD(EqualsAcrossLengths)
+		{
+			Assert::IsTrue(MString("\xE2\x84\xAA" "elvin").EqualsFolded("KELVIN"));
+			Assert::IsTrue(MString("\xCF\x82").EqualsFolded("\xCE\xA3"));
+			Assert::IsFalse(MString("k").EqualsFolded("kk"));
+			Assert::IsFalse(MString("\xC3\xA9").EqualsFolded("e"));
+			Assert::IsTrue(MString("").EqualsFolded(""));
+		}
+
+		TEST_METHOD(InvalidBytesOnlyMatchThemselves)
+		{
+			MString invalid("A\xFF" "B\xC3");
+			Assert::AreEqual("a\xFF" "b\xC3", invalid.FoldCase().Str());
+			Assert::IsTrue(invalid.EqualsFolded("a\xFF" "b\xC3"));
+			Assert::IsFalse(invalid.EqualsFolded("a\xFE" "b\xC3"));
+		}
+
+		TEST_METHOD(HashMatchesEquality)
+		{
+			MString upper;
+			MString lower;
+			for (unsigned int idx = 0; idx < 300; ++idx)
+			{
+				upper += idx % 3 ? MStringView("ABC") : MStringView("\xE2\x84\xAA\xCE\xA3");
+				lower += idx % 3 ? MStringView("abc") : MStringView("k\xCF\x82");
+				Assert::IsTrue(upper.EqualsFolded(lower));
+				Assert::AreEqual(upper.HashFolded(), lower.HashFolded());
+			}
+			Assert::AreEqual(MStringView("short").Hash(), MString("SHORT").HashFolded());
+			Assert::AreNotEqual(MString("abc").HashFolded(), MString("abd").HashFolded());
+		}
+
+		TEST_METHOD(FoldedContainerKeys)
+		{
+			std::unordered_set<MString, MStringFoldedHasher, MStringFoldedEqual> keys;
+			keys.insert("\xC3\x89t\xC3\xA9");
+			Assert::IsTrue(keys.count("\xC3\xA9T\xC3\x89") == 1);
+			Assert::IsTrue(keys.count("ete") == 0);
+		}
+	};
+}
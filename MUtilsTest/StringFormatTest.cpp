@@ -0,0 +1,81 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+
+#include "String.hpp"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace MUtilsTest
+{
+	struct Point
+	{
+		int	X;
+		int	Y;
+	};
+}
+
+template<>
+struct MFormatter<MUtilsTest::Point>
+{
+	static auto	Length(MUtilsTest::Point const& value) -> unsigned int { return 3 + MStringNumber::IntLength(value.X) + MStringNumber::IntLength(value.Y); }
+	static auto	Write(char* out, MUtilsTest::Point const& value) -> unsigned int
+	{
+		return MStringFormat::Write(out, MFORMAT("({},{})"), value.X, value.Y);
+	}
+};
+
+namespace MUtilsTest
+{
+	static_assert(MStringFormat::Placeholders("{} and {}") == 2, "two placeholders");
+	static_assert(MStringFormat::Placeholders("{{}}") == 0, "escaped braces are not placeholders");
+	static_assert(MStringFormat::Placeholders("{x}") == MStringFormat::InvalidFormat, "unmatched brace");
+	static_assert(MStringFormat::Placeholders("}") == MStringFormat::InvalidFormat, "unmatched brace");
+	static_assert(MStringFormat::LiteralLength("a{}b{{c}}") == 5, "literal chars");
+
+	TEST_CLASS(MStringFormatTest)
+	{
+	public:
+		TEST_METHOD(EveryArgumentType)
+		{
+			MString		name("name");
+			MString		str = MString::Format(MFORMAT("{}|{}|{}|{}|{}|{}|{}|{}|{}"), name, MStringView("view"), "literal", 'c', true, false,
+				-42, 18446744073709551615ull, 0.25f);
+			Assert::AreEqual("name|view|literal|c|true|false|-42|18446744073709551615|0.25", str.Str());
+		}
+
+		TEST_METHOD(EscapedBracesAndNoArguments)
+		{
+			Assert::AreEqual("{}", MString::Format(MFORMAT("{{}}")).Str());
+			Assert::AreEqual("{7}", MString::Format(MFORMAT("{{{}}}"), 7).Str());
+			Assert::AreEqual("", MString::Format(MFORMAT("")).Str());
+			Assert::AreEqual("abc", MString::Format(MFORMAT("{}"), "abc").Str());
+		}
+
+		TEST_METHOD(SizedExactlyWithoutFloats)
+		{
+			MString str = MString::Format(MFORMAT("{} items in {} ({})"), 123456u, MStringView("a container with a long name"), true);
+			Assert::AreEqual("123456 items in a container with a long name (true)", str.Str());
+			Assert::AreEqual(str.Count(), str.Capacity());
+		}
+
+		TEST_METHOD(CustomFormatter)
+		{
+			Point point = { -3, 14 };
+			Assert::AreEqual("at (-3,14)", MString::Format(MFORMAT("at {}"), point).Str());
+		}
+
+		TEST_METHOD(AppendFormatReadsItself)
+		{
+			MString str("self");
+			for (unsigned int idx = 0; idx < 4; ++idx)
+				str.AppendFormat(MFORMAT("[{}]"), str);
+			Assert::AreEqual("self[self][self[self]][self[self][self[self]]][self[self][self[self]][self[self][self[self]]]]", str.Str());
+
+			MString reserved;
+			reserved.Reserve(64);
+			reserved = "abc";
+			reserved.AppendFormat(MFORMAT("{}{}"), reserved, MStringView(reserved).Substr(1));
+			Assert::AreEqual("abcabcbc", reserved.Str());
+		}
+	};
+}
@@ -0,0 +1,110 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+
+#include <set>
+#include <unordered_map>
+
+#include "String.hpp"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace MUtilsTest
+{
+	static_assert("quit"_mh == MStringHash::ConstHash("quit", 4), "literal and function agree");
+	static_assert("quit"_mh != "Quit"_mh, "case matters");
+	static_assert(MStringHash::Distinct("load"_mh, "save"_mh, "quit"_mh, ""_mh), "distinct labels");
+	static_assert(!MStringHash::Distinct("load"_mh, "save"_mh, "load"_mh), "repeated label");
+
+	TEST_CLASS(MStringHashTest)
+	{
+	public:
+		TEST_METHOD(HashCoversEveryLength)
+		{
+			char buffer[130];
+			for (unsigned int idx = 0; idx < sizeof(buffer); ++idx)
+				buffer[idx] = (char)('a' + idx % 7);
+			std::set<unsigned long long> hashes;
+			for (unsigned int length = 0; length <= sizeof(buffer); ++length)
+				hashes.insert(MStringHash::Hash(buffer, length));
+			Assert::AreEqual((size_t)sizeof(buffer) + 1, hashes.size());
+		}
+
+		TEST_METHOD(NulIsHashedLikeAnyByte)
+		{
+			Assert::AreNotEqual(MStringView("a", 1).Hash(), MStringView("a\0", 2).Hash());
+			Assert::AreNotEqual(MStringView("a\0b", 3).Hash(), MStringView("a\0c", 3).Hash());
+			Assert::AreNotEqual(MStringHash::Hash("abc", 3, 1), MStringHash::Hash("abc", 3, 2));
+		}
+
+		TEST_METHOD(StringAndViewAgree)
+		{
+			MString str("a string long enough to be stored on the heap");
+			Assert::AreEqual(MStringView(str).Hash(), str.Hash());
+			Assert::AreEqual((size_t)str.Hash(), std::hash<MString>()(str));
+			Assert::AreEqual(MStringHasher()(str), MStringHasher()("a string long enough to be stored on the heap"));
+		}
+
+		TEST_METHOD(HashFollowsMutations)
+		{
+			MString str("value");
+			unsigned long long before = str.Hash();
+			str.Append('s');
+			Assert::AreNotEqual(before, str.Hash());
+			Assert::AreEqual(MStringHash::Hash("values"), str.Hash());
+			str[0] = 'V';
+			Assert::AreEqual(MStringHash::Hash("Values"), str.Hash());
+			str.ToUpperInPlace();
+			Assert::AreEqual(MStringHash::Hash("VALUES"), str.Hash());
+			str.Empty();
+			Assert::AreEqual(MStringHash::Hash(""), str.Hash());
+			str = "assigned";
+			Assert::AreEqual(MStringHash::Hash("assigned"), str.Hash());
+			MString moved(std::move(str));
+			Assert::AreEqual(MStringHash::Hash("assigned"), moved.Hash());
+			Assert::AreEqual(MStringHash::Hash(""), str.Hash());
+		}
+
+		TEST_METHOD(ConstHashMatchesHash)
+		{
+			char buffer[130];
+			for (unsigned int idx = 0; idx < sizeof(buffer); ++idx)
+				buffer[idx] = (char)(idx * 37 + 11);
+			for (unsigned int length = 0; length <= sizeof(buffer); ++length)
+			{
+				Assert::AreEqual(MStringHash::Hash(buffer, length), MStringHash::ConstHash(buffer, length));
+				Assert::AreEqual(MStringHash::Hash(buffer, length, 99), MStringHash::ConstHash(buffer, length, 99));
+			}
+			Assert::AreEqual(MString("a longer command name, past the 48 bytes loop of the hash").Hash(),
+				"a longer command name, past the 48 bytes loop of the hash"_mh);
+			Assert::AreEqual(MStringView("a\0b", 3).Hash(), "a\0b"_mh);
+		}
+
+		TEST_METHOD(SwitchOnString)
+		{
+			char const* commands[] = { "load", "save", "quit", "other" };
+			unsigned int results[4];
+			for (unsigned int idx = 0; idx < 4; ++idx)
+			{
+				MString command(commands[idx]);
+				switch (command.Hash())
+				{
+				case "load"_mh: results[idx] = 1; break;
+				case "save"_mh: results[idx] = 2; break;
+				case "quit"_mh: results[idx] = 3; break;
+				default: results[idx] = 0; break;
+				}
+			}
+			Assert::IsTrue(results[0] == 1 && results[1] == 2 && results[2] == 3 && results[3] == 0);
+		}
+
+		TEST_METHOD(TransparentLookup)
+		{
+			std::unordered_map<MString, int, MStringHasher, MStringEqual> map;
+			map["first"] = 1;
+			map["second"] = 2;
+			Assert::AreEqual(2, map[MString("second")]);
+			Assert::AreEqual(MStringHasher()(MStringView("first")), MStringHasher()(MString("first")));
+			Assert::IsTrue(MStringEqual()(MString("first"), "first"));
+		}
+	};
+}
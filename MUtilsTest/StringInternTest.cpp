@@ -0,0 +1,95 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+
+#include <thread>
+
+#include "Strings/StringIntern.hpp"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace MUtilsTest
+{
+	TEST_CLASS(MStringInternTest)
+	{
+	public:
+		TEST_METHOD(EqualStringsShareId)
+		{
+			MStringInternTable	table;
+			MString				copy("texture");
+			MStringId			first = table.Intern("texture");
+			Assert::IsTrue(first.IsValid());
+			Assert::IsTrue(first == table.Intern(copy));
+			Assert::IsTrue(first != table.Intern("Texture"));
+			Assert::IsTrue(first == table.Find("texture"));
+			Assert::AreEqual("texture", table.Resolve(first));
+		}
+
+		TEST_METHOD(FindUnknownAndInvalid)
+		{
+			MStringInternTable table;
+			Assert::IsFalse(table.Find("missing").IsValid());
+			Assert::AreEqual("", table.Resolve(MStringId()));
+			Assert::IsTrue(table.ResolveView(MStringId()).IsEmpty());
+		}
+
+		TEST_METHOD(EmptyAndEmbeddedNul)
+		{
+			MStringInternTable	table;
+			MStringId			empty = table.Intern("");
+			MStringId			withNul = table.Intern(MStringView("a\0b", 3));
+			Assert::IsTrue(empty.IsValid());
+			Assert::AreEqual(0u, table.ResolveView(empty).Count());
+			Assert::IsTrue(withNul != table.Intern("a"));
+			Assert::IsTrue(table.ResolveView(withNul) == MStringView("a\0b", 3));
+		}
+
+		TEST_METHOD(IdsStayValidWhileGrowing)
+		{
+			MStringInternTable			table;
+			std::vector<MStringId>		ids;
+			for (unsigned int idx = 0; idx < 100000; ++idx)
+				ids.push_back(table.Intern(MString::FromUInt(idx)));
+			Assert::AreEqual(100000u, table.GetStats().Strings);
+			for (unsigned int idx = 0; idx < 100000; idx += 7)
+			{
+				Assert::IsTrue(table.ResolveView(ids[idx]) == MString::FromUInt(idx));
+				Assert::IsTrue(table.Find(MString::FromUInt(idx)) == ids[idx]);
+			}
+		}
+
+		TEST_METHOD(ConcurrentInternAgrees)
+		{
+			MStringInternTable			table;
+			std::vector<MStringId>		ids[4];
+			std::vector<std::thread>	threads;
+			for (unsigned int thread = 0; thread < 4; ++thread)
+			{
+				threads.emplace_back([&table, &ids, thread]()
+				{
+					for (unsigned int idx = 0; idx < 5000; ++idx)
+						ids[thread].push_back(table.Intern(MString::FromUInt((idx * (thread + 1)) % 5000)));
+				});
+			}
+			for (std::thread& thread : threads)
+				thread.join();
+			Assert::AreEqual(5000u, table.GetStats().Strings);
+			for (unsigned int thread = 0; thread < 4; ++thread)
+			{
+				for (unsigned int idx = 0; idx < 5000; ++idx)
+					Assert::IsTrue(ids[thread][idx] == table.Find(MString::FromUInt((idx * (thread + 1)) % 5000)));
+			}
+		}
+
+		TEST_METHOD(StatsCountRequests)
+		{
+			MStringInternTable table;
+			table.Intern("abc");
+			table.Intern("abc");
+			table.Intern("defg");
+			MStringInternTable::Stats stats = table.GetStats();
+			Assert::AreEqual(2u, stats.Strings);
+			Assert::AreEqual(3ull, stats.Requests);
+			Assert::AreEqual(13ull, stats.RequestedBytes);
+		}
+	};
+}
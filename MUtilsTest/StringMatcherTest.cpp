@@ -0,0 +1,119 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+#include "Strings/StringMatcher.hpp"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace MUtilsTest
+{
+	TEST_CLASS(MStringMatcherTest)
+	{
+	public:
+		TEST_METHOD(OverlappingMatchesInEndOrder)
+		{
+			MStringMatcher matcher;
+			matcher.AddPattern("he");
+			matcher.AddPattern("she");
+			matcher.AddPattern("his");
+			matcher.AddPattern("hers");
+			matcher.Build();
+			std::vector<MStringMatcher::Match> matches;
+			Assert::AreEqual(4u, matcher.FindAll("ushers and his", matches));
+			unsigned int expected[4][2] = { { 1, 1 }, { 0, 2 }, { 3, 2 }, { 2, 11 } };
+			for (unsigned int idx = 0; idx < 4; ++idx)
+			{
+				Assert::AreEqual(expected[idx][0], matches[idx].Pattern);
+				Assert::AreEqual(expected[idx][1], matches[idx].Offset);
+			}
+		}
+
+		TEST_METHOD(MatchesNaiveSearch)
+		{
+			srand(14);
+			for (unsigned int round = 0; round < 300; ++round)
+			{
+				MStringMatcher				matcher;
+				std::vector<std::string>	patterns;
+				unsigned int				patternCount = 1 + rand() % (round % 2 ? 3 : 20);
+				for (unsigned int idx = 0; idx < patternCount; ++idx)
+				{
+					patterns.push_back(randomText(rand() % 5));
+					Assert::AreEqual(idx, matcher.AddPattern(MStringView(patterns.back())));
+				}
+				matcher.Build();
+				std::string text = randomText(rand() % 200);
+
+				std::vector<std::pair<unsigned int, unsigned int>> expected;
+				for (unsigned int end = 1; end <= text.size(); ++end)
+				{
+					for (unsigned int idx = 0; idx < patternCount; ++idx)
+					{
+						size_t length = patterns[idx].size();
+						if (length && length <= end && text.compare(end - length, length, patterns[idx]) == 0)
+							expected.push_back(std::make_pair(end, idx));
+					}
+				}
+				std::vector<MStringMatcher::Match>					matches;
+				std::vector<std::pair<unsigned int, unsigned int>>	found;
+				matcher.FindAll(MStringView(text), matches);
+				for (MStringMatcher::Match const& match : matches)
+					found.push_back(std::make_pair(match.Offset + (unsigned int)patterns[match.Pattern].size(), match.Pattern));
+				Assert::IsTrue(std::is_sorted(found.begin(), found.end(), [](std::pair<unsigned int, unsigned int> const& first, std::pair<unsigned int, unsigned int> const& second) { return first.first < second.first; }));
+				std::sort(found.begin(), found.end());
+				Assert::IsTrue(found == expected);
+				Assert::AreEqual(!expected.empty(), matcher.ContainsAny(MStringView(text)));
+			}
+		}
+
+		TEST_METHOD(DuplicateAndEmptyPatterns)
+		{
+			MStringMatcher matcher;
+			matcher.AddPattern("");
+			matcher.AddPattern("ab");
+			matcher.AddPattern("ab");
+			matcher.Build();
+			std::vector<MStringMatcher::Match> matches;
+			Assert::AreEqual(2u, matcher.FindAll("xab", matches));
+			Assert::AreEqual(1u, matches[0].Pattern);
+			Assert::AreEqual(2u, matches[1].Pattern);
+			Assert::IsFalse(matcher.ContainsAny(""));
+		}
+
+		TEST_METHOD(ScanStopsEarly)
+		{
+			MStringMatcher matcher;
+			matcher.AddPattern("a");
+			matcher.Build();
+			unsigned int calls = 0;
+			matcher.Scan("aaaa", [&calls](MStringMatcher::Match const&) { return ++calls < 2; });
+			Assert::AreEqual(2u, calls);
+		}
+
+		TEST_METHOD(PatternsNeedBuild)
+		{
+			MStringMatcher matcher;
+			matcher.AddPattern("needle");
+			Assert::IsFalse(matcher.IsBuilt());
+			Assert::IsFalse(matcher.ContainsAny("needle"));
+			matcher.Build();
+			matcher.AddPattern("pin");
+			Assert::IsFalse(matcher.ContainsAny("pin"));
+			matcher.Build();
+			Assert::IsTrue(matcher.ContainsAny("a pin"));
+			Assert::IsTrue(matcher.ContainsAny(MStringView("\0needle", 7)));
+		}
+
+	private:
+		static auto	randomText(unsigned int length) -> std::string
+		{
+			std::string text;
+			for (unsigned int idx = 0; idx < length; ++idx)
+				text += "abcd\0\xff"[rand() % 6];
+			return text;
+		}
+	};
+}
@@ -0,0 +1,128 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+
+#include <cstdlib>
+
+#include "String.hpp"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace MUtilsTest
+{
+	TEST_CLASS(MStringNumberTest)
+	{
+	public:
+		TEST_METHOD(IntegerExtremes)
+		{
+			MString str;
+			str.AppendInt(-9223372036854775807ll - 1);
+			Assert::AreEqual("-9223372036854775808", str.Str());
+			Assert::AreEqual("4294967295", MString::FromUInt(0xFFFFFFFF).Str());
+			Assert::AreEqual("0", MString::FromInt(0).Str());
+
+			long long value = 0;
+			Assert::AreEqual(20u, str.ParseInt(value));
+			Assert::IsTrue(value == -9223372036854775807ll - 1);
+			Assert::AreEqual(0u, MString("9223372036854775808").ParseInt(value));
+			unsigned long long big = 0;
+			Assert::AreEqual(20u, MString("18446744073709551615").ParseUInt(big));
+			Assert::AreEqual(0u, MString("18446744073709551616").ParseUInt(big));
+		}
+
+		TEST_METHOD(NarrowParseRejectsOverflow)
+		{
+			int				value = 7;
+			unsigned int	unsignedValue = 7;
+			Assert::AreEqual(11u, MString("-2147483648").ParseInt(value));
+			Assert::AreEqual(-2147483647 - 1, value);
+			Assert::AreEqual(0u, MString("2147483648").ParseInt(value));
+			Assert::AreEqual(0u, MString("4294967296").ParseUInt(unsignedValue));
+			Assert::AreEqual(7u, unsignedValue);
+		}
+
+		TEST_METHOD(ParseConsumesPrefix)
+		{
+			int value = 0;
+			Assert::AreEqual(2u, MString("12abc").ParseInt(value));
+			Assert::AreEqual(12, value);
+			Assert::AreEqual(2u, MString("+5").ParseInt(value));
+			Assert::AreEqual(5, value);
+			Assert::AreEqual(0u, MString("-").ParseInt(value));
+			Assert::AreEqual(0u, MString("-+5").ParseInt(value));
+			Assert::AreEqual(0u, MString(" 5").ParseInt(value));
+			Assert::AreEqual(0u, MString("").ParseInt(value));
+		}
+
+		TEST_METHOD(FloatShortestText)
+		{
+			Assert::AreEqual("0.1", MString::FromFloat(0.1f).Str());
+			Assert::AreEqual("1", MString::FromFloat(1.0f).Str());
+			Assert::AreEqual("0.5", MString::FromFloat(0.5f).Str());
+			Assert::AreEqual("100", MString::FromFloat(100.0f).Str());
+			Assert::AreEqual("1e+10", MString::FromFloat(1e10f).Str());
+			Assert::AreEqual("-0", MString::FromFloat(-0.0f).Str());
+			Assert::AreEqual("3.4028235e+38", MString::FromFloat(3.4028235e38f).Str());
+			Assert::AreEqual("1e-45", MString::FromFloat(1e-45f).Str());
+		}
+
+		TEST_METHOD(FloatSpecialValues)
+		{
+			unsigned int	nanBits = 0x7FC00000u;
+			unsigned int	infBits = 0x7F800000u;
+			float			nan;
+			float			inf;
+			memcpy(&nan, &nanBits, sizeof(float));
+			memcpy(&inf, &infBits, sizeof(float));
+			Assert::AreEqual("nan", MString::FromFloat(nan).Str());
+			Assert::AreEqual("inf", MString::FromFloat(inf).Str());
+			Assert::AreEqual("-inf", MString::FromFloat(-inf).Str());
+
+			float value = 0.0f;
+			Assert::AreEqual(8u, MString("Infinity").ParseFloat(value));
+			Assert::IsTrue(value == inf);
+			Assert::AreEqual(4u, MString("-inf").ParseFloat(value));
+			Assert::IsTrue(value == -inf);
+			Assert::AreEqual(3u, MString("NaN").ParseFloat(value));
+			Assert::IsTrue(value != value);
+		}
+
+		TEST_METHOD(FloatRoundTrip)
+		{
+			unsigned int seed = 8;
+			for (unsigned int round = 0; round < 100000; ++round)
+			{
+				seed ^= seed << 13;
+				seed ^= seed >> 17;
+				seed ^= seed << 5;
+				unsigned int bits = seed;
+				if (((bits >> 23) & 0xFF) == 0xFF)
+					continue;
+				float value;
+				memcpy(&value, &bits, sizeof(float));
+				MString	text = MString::FromFloat(value);
+				float	parsed = 0.0f;
+				Assert::AreEqual(text.Count(), text.ParseFloat(parsed));
+				unsigned int parsedBits;
+				memcpy(&parsedBits, &parsed, sizeof(float));
+				Assert::AreEqual(bits, parsedBits);
+				Assert::IsTrue(text.Count() <= MStringNumber::MaxFloatChars);
+			}
+		}
+
+		TEST_METHOD(FloatParseIsCorrectlyRounded)
+		{
+			char const* inputs[] = { "0.1", "3.14159265358979", "1e-46", "7e-46", "1.17549435e-38", "3.4028236e38", "3.5e38",
+				"123456789012345678901234567890", "0.000000000000000000000000000000000000000000001401298464324817", ".5", "5.", "1E5" };
+			for (char const* input : inputs)
+			{
+				float value = 0.0f;
+				Assert::AreEqual((unsigned int)strlen(input), MString(input).ParseFloat(value));
+				Assert::IsTrue(value == strtof(input, nullptr));
+			}
+			float value = 2.0f;
+			Assert::AreEqual(0u, MString(".").ParseFloat(value));
+			Assert::AreEqual(1u, MString("1e").ParseFloat(value));
+			Assert::AreEqual(1.0f, value);
+		}
+	};
+}
@@ -0,0 +1,100 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+
+#include <cstdlib>
+
+#include "String.hpp"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace MUtilsTest
+{
+	TEST_CLASS(MStringSearchTest)
+	{
+	public:
+		TEST_METHOD(FindMatchesNaiveSearch)
+		{
+			srand(6);
+			for (unsigned int round = 0; round < 2000; ++round)
+			{
+				std::string hay = randomText(rand() % 80);
+				std::string needle = randomText(1 + rand() % 4);
+				unsigned int from = rand() % (hay.size() + 2);
+				size_t expected = from <= hay.size() ? hay.find(needle, from) : std::string::npos;
+				unsigned int found = MStringView(hay).Find(MStringView(needle), from);
+				Assert::IsTrue(expected == std::string::npos ? found == MStringView::Npos : found == (unsigned int)expected);
+
+				unsigned int before = rand() % (hay.size() + 2);
+				expected = hay.rfind(needle, before);
+				found = MStringView(hay).RFind(MStringView(needle), before);
+				Assert::IsTrue(expected == std::string::npos ? found == MStringView::Npos : found == (unsigned int)expected);
+			}
+		}
+
+		TEST_METHOD(FindAtBlockEdges)
+		{
+			for (unsigned int length = 2; length < 70; ++length)
+			{
+				std::string hay(length, 'a');
+				hay[length - 2] = 'x';
+				hay[length - 1] = 'y';
+				Assert::AreEqual(length - 2, MStringView(hay).Find("xy"));
+				Assert::AreEqual(length - 2, MStringView(hay).RFind("xy"));
+				Assert::IsTrue(MStringView(hay.data(), length - 1).Find("xy") == MStringView::Npos);
+			}
+		}
+
+		TEST_METHOD(EmbeddedNulAndHighBytes)
+		{
+			MStringView hay("ab\0cd\xe9\xff", 7);
+			Assert::AreEqual(2u, hay.Find(MStringView("\0c", 2)));
+			Assert::AreEqual(5u, hay.Find("\xe9\xff"));
+			Assert::AreEqual(6u, hay.FindAny("\xff"));
+			Assert::AreEqual(2u, hay.FindAny(MStringView("\0\xe9", 2)));
+		}
+
+		TEST_METHOD(EmptyNeedle)
+		{
+			MStringView hay("abc");
+			Assert::AreEqual(0u, hay.Find(""));
+			Assert::AreEqual(3u, hay.Find("", 3));
+			Assert::IsTrue(hay.Find("", 4) == MStringView::Npos);
+			Assert::AreEqual(3u, hay.RFind(""));
+			Assert::AreEqual(0u, hay.Count(""));
+			Assert::IsTrue(hay.FindAny("") == MStringView::Npos);
+		}
+
+		TEST_METHOD(CountIsNonOverlapping)
+		{
+			Assert::AreEqual(2u, MStringView("aaaa").Count("aa"));
+			Assert::AreEqual(1u, MStringView("aaa").Count("aa"));
+			Assert::AreEqual(3u, MString("a.b.c.").Count("."));
+		}
+
+		TEST_METHOD(FindAnyLargeSet)
+		{
+			std::string hay(100, '-');
+			hay[77] = 'Q';
+			Assert::AreEqual(77u, MStringView(hay).FindAny("ABCDEFGHIJKLMNOPQRSTUVWXYZ"));
+			Assert::AreEqual(77u, MStringView(hay).FindAny("XYZQ"));
+			Assert::IsTrue(MStringView(hay).FindAny("XYZQ", 78) == MStringView::Npos);
+		}
+
+		TEST_METHOD(CompareIsLengthAware)
+		{
+			Assert::IsTrue(MString("abc") == MStringView("abcd", 3));
+			Assert::IsFalse(MString(MStringView("a\0b", 3)) == "a");
+			Assert::IsTrue(MString("ab") < "abc");
+			Assert::IsTrue(MString("") < "a");
+		}
+
+	private:
+		static auto	randomText(unsigned int length) -> std::string
+		{
+			std::string text;
+			for (unsigned int idx = 0; idx < length; ++idx)
+				text += "abc\0"[rand() % 4];
+			return text;
+		}
+	};
+}
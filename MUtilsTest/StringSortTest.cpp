@@ -0,0 +1,91 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+#include "Strings/StringSort.hpp"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace MUtilsTest
+{
+	TEST_CLASS(MStringSortTest)
+	{
+	public:
+		TEST_METHOD(MatchesStdSort)
+		{
+			srand(17);
+			unsigned int sizes[] = { 0, 1, 2, 15, 100, 3000, 20000 };
+			for (unsigned int size : sizes)
+			{
+				std::vector<MString> strings = randomStrings(size);
+				std::vector<MString> expected = strings;
+				std::sort(expected.begin(), expected.end());
+				MStringSort::Sort(strings);
+				Assert::IsTrue(strings == expected);
+			}
+		}
+
+		TEST_METHOD(ThreadedSortMatchesStdSort)
+		{
+			srand(18);
+			std::vector<MString>		strings = randomStrings(50000);
+			std::vector<MStringView>	views(strings.begin(), strings.end());
+			std::vector<MString>		expected = strings;
+			std::sort(expected.begin(), expected.end());
+			MStringSort::Sort(views, MStringSort::AllThreads);
+			for (unsigned int idx = 0; idx < views.size(); ++idx)
+				Assert::IsTrue(views[idx] == expected[idx]);
+			//Sorting moves the strings, the views of short ones are not valid past this point
+			MStringSort::Sort(strings, 4);
+			Assert::IsTrue(strings == expected);
+		}
+
+		TEST_METHOD(StableSortKeepsEqualKeysInOrder)
+		{
+			struct Item
+			{
+				MString			Key;
+				unsigned int	Index;
+			};
+			srand(19);
+			std::vector<Item> items;
+			for (unsigned int idx = 0; idx < 5000; ++idx)
+				items.push_back(Item{ MString(rand() % 2 ? "a key sharing a long prefix " : "") + MString::FromUInt(rand() % 50), idx });
+			std::vector<Item> expected = items;
+			std::stable_sort(expected.begin(), expected.end(), [](Item const& first, Item const& second) { return first.Key < second.Key; });
+			MStringSort::StableSortBy(items.data(), (unsigned int)items.size(), [](Item const& item) { return MStringView(item.Key); }, 2);
+			for (unsigned int idx = 0; idx < items.size(); ++idx)
+				Assert::AreEqual(expected[idx].Index, items[idx].Index);
+		}
+
+		TEST_METHOD(OrderLeavesKeysInPlace)
+		{
+			MStringView					keys[] = { "pear", "apple", "", "apple pie", "Zebra" };
+			std::vector<unsigned int>	order;
+			MStringSort::Order(keys, 5, order, true);
+			unsigned int expected[] = { 2, 4, 1, 3, 0 };
+			for (unsigned int idx = 0; idx < 5; ++idx)
+				Assert::AreEqual(expected[idx], order[idx]);
+			Assert::IsTrue(keys[0] == "pear");
+		}
+
+	private:
+		//Long shared prefixes, NULs, high bytes, duplicates and empty strings
+		static auto	randomStrings(unsigned int count) -> std::vector<MString>
+		{
+			char const*				prefixes[] = { "", "textures/characters/", "textures/characters/hero", "\xff\xfe", "a" };
+			std::vector<MString>	strings;
+			for (unsigned int idx = 0; idx < count; ++idx)
+			{
+				MString str(prefixes[rand() % 5]);
+				unsigned int length = rand() % 12;
+				for (unsigned int pos = 0; pos < length; ++pos)
+					str += "ab\0\x80z"[rand() % 5];
+				strings.push_back(std::move(str));
+			}
+			return strings;
+		}
+	};
+}
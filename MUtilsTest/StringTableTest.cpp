@@ -0,0 +1,200 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <map>
+
+#include "Strings/StringTable.hpp"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace MUtilsTest
+{
+	TEST_CLASS(MStringTableTest)
+	{
+	public:
+		TEST_METHOD(EmptyTable)
+		{
+			MStringTable table;
+			Assert::AreEqual(0u, table.Count());
+			Assert::IsFalse(table.Contains(""));
+			Assert::IsTrue(table.Save("MStringTableEmpty.bin"));
+			Assert::IsTrue(table.Load("MStringTableEmpty.bin"));
+			Assert::AreEqual(0u, table.Count());
+			Assert::IsTrue(table.Find("a") == MStringTable::NotFound);
+			Assert::AreEqual(0u, table.Add(""));
+			Assert::IsFalse(table.IsMapped());
+			Assert::IsTrue(table.String(0).IsEmpty());
+			Assert::IsTrue(table.Contains(""));
+			std::remove("MStringTableEmpty.bin");
+		}
+
+		TEST_METHOD(AddGivesStableIds)
+		{
+			srand(25);
+			MStringTable							table;
+			std::map<std::string, unsigned int>		expected;
+			for (unsigned int round = 0; round < 20000; ++round)
+			{
+				std::string		str = "name_" + std::to_string(rand() % 5000);
+				unsigned int	id = table.Add(MStringView(str));
+				auto			found = expected.find(str);
+				if (found != expected.end())
+					Assert::AreEqual(found->second, id);
+				else
+				{
+					Assert::AreEqual((unsigned int)expected.size(), id);
+					expected[str] = id;
+				}
+			}
+			Assert::AreEqual((unsigned int)expected.size(), table.Count());
+			checkContents(table, expected);
+		}
+
+		TEST_METHOD(SaveAndLoad)
+		{
+			MStringTable							table;
+			std::map<std::string, unsigned int>		expected;
+			for (unsigned int idx = 0; idx < 1000; ++idx)
+			{
+				std::string str = "key" + std::to_string(idx * 7);
+				expected[str] = table.Add(MStringView(str));
+			}
+			expected[""] = table.Add("");
+			Assert::IsTrue(table.Save("MStringTableTest.bin"));
+			{
+				MStringTable loaded;
+				Assert::IsTrue(loaded.Load("MStringTableTest.bin"));
+				Assert::IsTrue(loaded.IsMapped());
+				Assert::AreEqual(table.Count(), loaded.Count());
+				checkContents(loaded, expected);
+				Assert::IsTrue(loaded.Find("key1") == MStringTable::NotFound);
+
+				//Adding copies the table out of the file
+				Assert::AreEqual(table.Count(), loaded.Add("fresh"));
+				Assert::IsFalse(loaded.IsMapped());
+				expected["fresh"] = table.Count();
+				checkContents(loaded, expected);
+			}
+			std::remove("MStringTableTest.bin");
+		}
+
+		TEST_METHOD(DamagedFiles)
+		{
+			MStringTable table;
+			table.Add("alpha");
+			table.Add("beta");
+			table.Add("");
+			Assert::IsTrue(table.Verify());
+			Assert::IsTrue(table.Save("MStringTableDamaged.bin"));
+			std::vector<char> good = readFile("MStringTableDamaged.bin");
+
+			//Header, slots of a hash and an id, then the offsets of the 3 strings and the chars
+			unsigned int slotCount;
+			memcpy(&slotCount, good.data() + 16, 4);
+			unsigned int	offsetsAt = 32 + 8 * slotCount;
+			unsigned int	charsAt = offsetsAt + 4 * 4;
+			std::vector<unsigned int> usedSlots;
+			for (unsigned int slot = 0; slot < slotCount; ++slot)
+			{
+				unsigned int id;
+				memcpy(&id, good.data() + 32 + 8 * slot + 4, 4);
+				if (id != MStringTable::NotFound)
+					usedSlots.push_back(32 + 8 * slot);
+			}
+
+			//Load only reads the header, the sizes and both ends of the offsets and of the chars
+			unsigned int	rejected[][2] = { { 0, 0x4254534E }, { 4, 2 }, { 12, 100 }, { 16, 2 }, { offsetsAt, 1 }, { offsetsAt + 12, 10 }, { charsAt + 8, 0x61616161 } };
+			for (auto const& damage : rejected)
+			{
+				writeFile("MStringTableDamaged.bin", damaged(good, damage[0], damage[1]));
+				MStringTable loaded;
+				loaded.Add("alpha");
+				Assert::IsFalse(loaded.Load("MStringTableDamaged.bin"));
+				Assert::AreEqual(0u, loaded.Count());
+				Assert::IsFalse(loaded.Contains("alpha"));
+			}
+			writeFile("MStringTableDamaged.bin", std::vector<char>(good.begin(), good.begin() + 20));
+			Assert::IsFalse(MStringTable().Load("MStringTableDamaged.bin"));
+
+			//Damaged offsets and slots are found by Verify, queries stay in bounds and stop until then
+			unsigned int firstHash;
+			unsigned int firstId;
+			memcpy(&firstHash, good.data() + usedSlots[0], 4);
+			memcpy(&firstId, good.data() + usedSlots[0] + 4, 4);
+			unsigned int	loadedDamages[][2] = { { offsetsAt + 4, 0 }, { offsetsAt + 4, 5 }, { offsetsAt + 4, 100 }, { usedSlots[0] + 4, 7 }, { usedSlots[0], firstHash + 1 },
+				{ usedSlots[1] + 4, firstId }, { usedSlots[0] + 4, MStringTable::NotFound } };
+			std::vector<std::vector<char>> files;
+			for (auto const& damage : loadedDamages)
+				files.push_back(damaged(good, damage[0], damage[1]));
+			//No empty slot left to stop the probing
+			files.push_back(good);
+			memset(files.back().data() + 32, 0, 8 * slotCount);
+			for (std::vector<char> const& bad : files)
+			{
+				writeFile("MStringTableDamaged.bin", bad);
+				MStringTable loaded;
+				Assert::IsTrue(loaded.Load("MStringTableDamaged.bin"));
+				Assert::IsFalse(loaded.Verify());
+				Assert::IsTrue(loaded.Find("absent") == MStringTable::NotFound);
+				char const* strs[] = { "alpha", "beta", "" };
+				for (char const* str : strs)
+				{
+					unsigned int id = loaded.Find(str);
+					Assert::IsTrue(id == MStringTable::NotFound || id < loaded.Count());
+				}
+				for (unsigned int id = 0; id < loaded.Count(); ++id)
+					Assert::IsTrue(loaded.String(id).Count() <= 10);
+
+				//Adding rebuilds the slots from the strings
+				unsigned int id = loaded.Add("gamma");
+				Assert::IsFalse(loaded.IsMapped());
+				Assert::AreEqual(3u, id);
+				Assert::AreEqual(id, loaded.Find("gamma"));
+				Assert::IsTrue(loaded.Find("absent") == MStringTable::NotFound);
+			}
+
+			writeFile("MStringTableDamaged.bin", good);
+			MStringTable loaded;
+			Assert::IsTrue(loaded.Load("MStringTableDamaged.bin"));
+			Assert::IsTrue(loaded.Verify());
+			Assert::AreEqual(1u, loaded.Find("beta"));
+			std::remove("MStringTableDamaged.bin");
+			Assert::IsFalse(MStringTable().Load("MStringTableDamaged.bin"));
+		}
+
+	private:
+		static auto	checkContents(MStringTable const& table, std::map<std::string, unsigned int> const& expected) -> void
+		{
+			for (auto const& entry : expected)
+			{
+				MStringView str = table.String(entry.second);
+				Assert::IsTrue(str == MStringView(entry.first));
+				Assert::IsTrue(str.Data()[str.Count()] == '\0');
+				Assert::AreEqual(entry.second, table.Find(MStringView(entry.first)));
+			}
+		}
+
+		static auto	readFile(char const* path) -> std::vector<char>
+		{
+			std::ifstream in(path, std::ios::binary);
+			return std::vector<char>(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+		}
+
+		static auto	damaged(std::vector<char> content, unsigned int at, unsigned int value) -> std::vector<char>
+		{
+			memcpy(content.data() + at, &value, 4);
+			return content;
+		}
+
+		static auto	writeFile(char const* path, std::vector<char> const& content) -> void
+		{
+			std::ofstream out(path, std::ios::binary | std::ios::trunc);
+			out.write(content.data(), content.size());
+		}
+	};
+}
@@ -0,0 +1,389 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+
+#include <type_traits>
+#include <utility>
+
+#include "String.hpp"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace MUtilsTest
+{
+	//A concatenation references its operands, only the temporary returned by the operators may be used.
+	//auto named = a + b still compiles since C++17, these check nothing can be done with it.
+	template<class Concat, class = void>
+	struct IsComparable : std::false_type {};
+	template<class Concat>
+	struct IsComparable<Concat, decltype((void)(std::declval<Concat>() == MStringView()))> : std::true_type {};
+
+	template<class Concat, class = void>
+	struct IsExtensible : std::false_type {};
+	template<class Concat>
+	struct IsExtensible<Concat, decltype((void)(std::declval<Concat>() + 'x'))> : std::true_type {};
+
+	template<class Concat, class = void>
+	struct IsAppendable : std::false_type {};
+	template<class Concat>
+	struct IsAppendable<Concat, decltype((void)(std::declval<MString&>() += std::declval<Concat>()))> : std::true_type {};
+
+	using Concatenation = decltype(std::declval<MString const&>() + std::declval<MString const&>());
+
+	static_assert(std::is_constructible<MString, Concatenation>::value, "a temporary concatenation converts to MString");
+	static_assert(!std::is_constructible<MString, Concatenation&>::value, "a named concatenation must not convert");
+	static_assert(!std::is_constructible<MString, Concatenation const&>::value, "a named concatenation must not convert");
+	static_assert(IsComparable<Concatenation>::value && !IsComparable<Concatenation&>::value, "only a temporary concatenation compares");
+	static_assert(IsExtensible<Concatenation>::value && !IsExtensible<Concatenation&>::value, "only a temporary concatenation is extended");
+	static_assert(IsAppendable<Concatenation>::value && !IsAppendable<Concatenation&>::value, "only a temporary concatenation is appended");
+
+	TEST_CLASS(MStringTest)
+	{
+	public:
+		TEST_METHOD(EmptyStringIsLocal)
+		{
+			MString str;
+			Assert::IsTrue(str.IsLocal());
+			Assert::AreEqual(0u, str.Count());
+			Assert::AreEqual("", str.Str());
+		}
+
+		TEST_METHOD(LocalCapacityBoundary)
+		{
+			unsigned int local = MString::LocalCapacity;
+			MString fits("abcdefghijklmnopqrstuvw");
+			Assert::AreEqual(local, fits.Count());
+			Assert::IsTrue(fits.IsLocal());
+			Assert::AreEqual(local, fits.Capacity());
+
+			MString over("abcdefghijklmnopqrstuvwx");
+			Assert::AreEqual(local + 1, over.Count());
+			Assert::IsFalse(over.IsLocal());
+			Assert::AreEqual("abcdefghijklmnopqrstuvwx", over.Str());
+		}
+
+		TEST_METHOD(AppendLeavesLocalStorage)
+		{
+			MString str("abcdefghijklmnopqrstuv");
+			str.Append('w');
+			Assert::IsTrue(str.IsLocal());
+			str.Append('x');
+			Assert::IsFalse(str.IsLocal());
+			Assert::AreEqual("abcdefghijklmnopqrstuvwx", str.Str());
+		}
+
+		TEST_METHOD(RemoveKeepsContentAcrossBoundary)
+		{
+			MString str("abcdefghijklmnopqrstuvwxyz");
+			str.RemoveAt(20, 6);
+			Assert::AreEqual("abcdefghijklmnopqrst", str.Str());
+			str.InsertAt(0, "0123");
+			Assert::AreEqual("0123abcdefghijklmnopqrst", str.Str());
+		}
+
+		TEST_METHOD(MoveLocalCopiesContent)
+		{
+			MString source("short");
+			MString moved(std::move(source));
+			Assert::IsTrue(moved.IsLocal());
+			Assert::AreEqual("short", moved.Str());
+			Assert::AreEqual(0u, source.Count());
+			Assert::AreEqual("", source.Str());
+		}
+
+		TEST_METHOD(MoveHeapTakesBuffer)
+		{
+			MString source("a string that does not fit inside the object");
+			char const* buffer = source.Str();
+			MString moved(std::move(source));
+			Assert::IsTrue(moved.Str() == buffer);
+			Assert::IsTrue(source.IsLocal());
+			Assert::AreEqual(0u, source.Count());
+		}
+
+		TEST_METHOD(CopiesAreIndependent)
+		{
+			MString first("local");
+			MString second(first);
+			second[0] = 'L';
+			Assert::AreEqual("local", first.Str());
+			Assert::AreEqual("Local", second.Str());
+		}
+
+		TEST_METHOD(AppendGrowsGeometrically)
+		{
+			MString str;
+			unsigned int reallocations = 0;
+			unsigned int capacity = str.Capacity();
+			for (unsigned int idx = 0; idx < 10000; ++idx)
+			{
+				str.Append((char)('a' + idx % 26));
+				if (str.Capacity() != capacity)
+				{
+					Assert::IsTrue(str.Capacity() >= capacity * 2);
+					capacity = str.Capacity();
+					++reallocations;
+				}
+			}
+			Assert::AreEqual(10000u, str.Count());
+			Assert::IsTrue(reallocations <= 10);
+			for (unsigned int idx = 0; idx < 10000; ++idx)
+				Assert::AreEqual((char)('a' + idx % 26), str[idx]);
+		}
+
+		TEST_METHOD(ReserveKeepsBufferForAppends)
+		{
+			MString str;
+			str.Reserve(100);
+			Assert::AreEqual(100u, str.Capacity());
+			char const* buffer = str.Str();
+			for (unsigned int idx = 0; idx < 100; ++idx)
+				str += 'x';
+			Assert::IsTrue(str.Str() == buffer);
+			str.Reserve(10);
+			Assert::AreEqual(100u, str.Capacity());
+		}
+
+		TEST_METHOD(EmptyKeepsCapacity)
+		{
+			MString str("a string that does not fit inside the object");
+			unsigned int capacity = str.Capacity();
+			str.Empty();
+			Assert::AreEqual(0u, str.Count());
+			Assert::AreEqual("", str.Str());
+			Assert::AreEqual(capacity, str.Capacity());
+		}
+
+		TEST_METHOD(ShrinkToFit)
+		{
+			MString str;
+			str.Reserve(200);
+			str += "forty chars long, so it stays on heap!!!";
+			str.ShrinkToFit();
+			Assert::AreEqual(40u, str.Capacity());
+			Assert::AreEqual("forty chars long, so it stays on heap!!!", str.Str());
+			str.RemoveAt(5, 30);
+			str.ShrinkToFit();
+			Assert::IsTrue(str.IsLocal());
+			Assert::AreEqual("fortyap!!!", str.Str());
+		}
+
+		TEST_METHOD(AppendSelf)
+		{
+			MString str("0123456789abcdef");
+			str.Append(str);
+			str += str;
+			Assert::AreEqual("0123456789abcdef0123456789abcdef0123456789abcdef0123456789abcdef", str.Str());
+		}
+
+		TEST_METHOD(CopyThenWriteDetaches)
+		{
+			MString first("a string that does not fit inside the object");
+			MString second(first);
+#ifdef MSTRING_SHARED_BUFFERS
+			Assert::IsTrue(first.IsShared() && second.IsShared());
+			Assert::IsTrue(first.Str() == second.Str());
+#else
+			Assert::IsFalse(first.IsShared());
+#endif
+			second[0] = 'A';
+			Assert::IsFalse(first.IsShared() || second.IsShared());
+			Assert::AreEqual("a string that does not fit inside the object", first.Str());
+			Assert::AreEqual("A string that does not fit inside the object", second.Str());
+		}
+
+		TEST_METHOD(EveryMutationDetaches)
+		{
+			MString const original("  a string that does not fit inside the object  ");
+			MString edits[10] = { original, original, original, original, original, original, original, original, original, original };
+			edits[0].Append("!");
+			edits[1].ReplaceAll("t", "T");
+			edits[2].Empty();
+			edits[3].ToUpperInPlace();
+			edits[4].RemoveAt(0, 2);
+			edits[5].InsertAt(0, "*");
+			edits[6].ResizeForOverwrite(4)[0] = 'X';
+			edits[7] = edits[7] + "!";
+			edits[8].Trim();
+			edits[9].Replace("string", "thing");
+			for (MString const& edit : edits)
+				Assert::IsTrue(edit != original);
+			Assert::AreEqual("  a string that does not fit inside the object  ", original.Str());
+		}
+
+		TEST_METHOD(AssignmentReleasesSharedBuffer)
+		{
+			MString first("a string that does not fit inside the object");
+			MString second("another string that does not fit inside the object");
+			second = first;
+			first = "short";
+			Assert::IsFalse(second.IsShared());
+			Assert::AreEqual("a string that does not fit inside the object", second.Str());
+			MString third(second);
+			second = std::move(third);
+			Assert::IsFalse(second.IsShared());
+			Assert::AreEqual("a string that does not fit inside the object", second.Str());
+		}
+
+		TEST_METHOD(SharedCopyKeepsItsHash)
+		{
+			MString first("a string that does not fit inside the object");
+			unsigned long long hash = first.Hash();
+			MString second("previous content of the destination string");
+			second.Hash();
+			second = first;
+			Assert::AreEqual(hash, second.Hash());
+			first.Append('!');
+			Assert::AreEqual(hash, second.Hash());
+			Assert::AreEqual(MStringView(first).Hash(), first.Hash());
+		}
+
+		TEST_METHOD(AllocatorBuffersAreNotShared)
+		{
+			MStringArena	arena;
+			MString			scratch(MStringView("a string that does not fit inside the object"), &arena);
+			MString			copy(scratch);
+			Assert::IsFalse(scratch.IsShared() || copy.IsShared());
+			Assert::IsFalse(copy.Str() == scratch.Str());
+		}
+
+		TEST_METHOD(JoinKeepsEmptyParts)
+		{
+			Assert::AreEqual(",a,", MString::Join({ "", "a", "" }, ",").Str());
+			Assert::AreEqual(",", MString::Join({ "", "" }, ",").Str());
+			Assert::AreEqual("", MString::Join({ "" }, ",").Str());
+			Assert::AreEqual("", MString::Join(std::vector<MString>(), ", ").Str());
+			std::vector<MString> parts = { "first", "second", "third", "fourth" };
+			MString joined = MString::Join(parts, " - ");
+			Assert::AreEqual("first - second - third - fourth", joined.Str());
+			Assert::AreEqual(joined.Count(), joined.Capacity());
+		}
+
+		TEST_METHOD(ReplaceAllShrinksAndGrows)
+		{
+			MString str("a-b-c-d-e-f-g-h-i-j-k-l-m-n");
+			Assert::AreEqual(13u, str.ReplaceAll("-", ""));
+			Assert::AreEqual("abcdefghijklmn", str.Str());
+			Assert::AreEqual(0u, str.ReplaceAll("", "x"));
+			Assert::AreEqual(0u, str.ReplaceAll("z", "y"));
+			Assert::AreEqual(1u, str.ReplaceAll("abcdefghijklmn", "whole"));
+			Assert::AreEqual("whole", str.Str());
+			Assert::AreEqual(1u, str.ReplaceAll("o", "[longer replacement]"));
+			Assert::AreEqual("wh[longer replacement]le", str.Str());
+			MString overlapping("aaaa");
+			Assert::AreEqual(2u, overlapping.ReplaceAll("aa", "b"));
+			Assert::AreEqual("bb", overlapping.Str());
+		}
+
+		TEST_METHOD(ReplaceWithViewsOfItself)
+		{
+			MString str("abc-abc-abc");
+			Assert::AreEqual(3u, str.ReplaceAll(str.Substr(0, 3), str.Substr(0, 1)));
+			Assert::AreEqual("a-a-a", str.Str());
+			Assert::AreEqual(2u, str.ReplaceAll(str.Substr(1, 1), str));
+			Assert::AreEqual("aa-a-aaa-a-aa", str.Str());
+			Assert::IsTrue(str.Replace("a-", "", 3));
+			Assert::AreEqual("aa-aaa-a-aa", str.Str());
+			Assert::IsFalse(str.Replace("z", "y"));
+			Assert::IsFalse(str.Replace("", "y"));
+		}
+
+		TEST_METHOD(TrimInPlace)
+		{
+			MString str("  \t padded value that is longer than the local buffer \r\n");
+			str.Trim();
+			Assert::AreEqual("padded value that is longer than the local buffer", str.Str());
+			MString spaces("   ");
+			spaces.Trim();
+			Assert::AreEqual(0u, spaces.Count());
+			MString start(" x ");
+			start.TrimStart();
+			Assert::AreEqual("x ", start.Str());
+			start.TrimEnd();
+			Assert::AreEqual("x", start.Str());
+		}
+
+		TEST_METHOD(Repeat)
+		{
+			Assert::AreEqual("", MString("abc").Repeat(0).Str());
+			Assert::AreEqual("abc", MString("abc").Repeat(1).Str());
+			Assert::AreEqual("", MString().Repeat(10).Str());
+			MString repeated = MString("abc").Repeat(7);
+			Assert::AreEqual("abcabcabcabcabcabcabc", repeated.Str());
+			Assert::AreEqual(21u, repeated.Count());
+		}
+
+		TEST_METHOD(ConcatenationAllocatesOnce)
+		{
+			MString			first("a first part, ");
+			MString			second("a second part");
+			MStringArena	arena;
+			MString			target(&arena);
+			target = first + second + ", " + 'x' + MStringView(" and a view");
+			Assert::AreEqual("a first part, a second part, x and a view", target.Str());
+			Assert::AreEqual(target.Count(), target.Capacity());
+			Assert::AreEqual((unsigned long long)target.Count() + 1, arena.UsedBytes());
+
+			MString built = "prefix " + first + second;
+			Assert::AreEqual("prefix a first part, a second part", built.Str());
+			Assert::IsTrue(built.GetAllocator() == nullptr);
+		}
+
+		TEST_METHOD(ConcatenationCompares)
+		{
+			MString first("ab");
+			MString second("cd");
+			Assert::IsTrue(first + second == "abcd");
+			Assert::IsTrue("abcd" == first + second);
+			Assert::IsTrue(first + second != "abc");
+			Assert::IsTrue(first + second != "abcde");
+			Assert::IsTrue(first + second < "abce");
+			Assert::IsFalse(first + second < "abcd");
+			Assert::IsTrue(first + 'c' < "abcd");
+			Assert::AreEqual("abcd!", (first + second + '!').ToString().Str());
+		}
+
+		TEST_METHOD(ConcatenationReadsItself)
+		{
+			MString str("middle");
+			str = "[" + str + "]";
+			Assert::AreEqual("[middle]", str.Str());
+			str = str + str;
+			Assert::AreEqual("[middle][middle]", str.Str());
+			str += str + str.Substr(1, 6);
+			Assert::AreEqual("[middle][middle][middle][middle]middle", str.Str());
+			MString prefix("<");
+			str = prefix + str.Substr(1, 3);
+			Assert::AreEqual("<mid", str.Str());
+		}
+
+		TEST_METHOD(SelfAppendKeepsBuffer)
+		{
+			MString str;
+			str.Reserve(100);
+			str = "start";
+			char const* buffer = str.Str();
+			str = str + ", more" + ", and more";
+			Assert::IsTrue(str.Str() == buffer);
+			Assert::AreEqual("start, more, and more", str.Str());
+		}
+
+		TEST_METHOD(MovedLeftOperandAppends)
+		{
+			MString str("a string that does not fit inside the object");
+			str.Reserve(100);
+			char const* buffer = str.Str();
+			MString result = std::move(str) + " with a suffix" + '!';
+			Assert::IsTrue(result.Str() == buffer);
+			Assert::AreEqual("a string that does not fit inside the object with a suffix!", result.Str());
+			Assert::AreEqual("tail", (MString() + "tail").Str());
+		}
+
+		TEST_METHOD(LengthConstructorStopsAtTerminator)
+		{
+			MString str("abc", 10);
+			Assert::AreEqual(3u, str.Count());
+			MString cut("abcdef", 2);
+			Assert::AreEqual("ab", cut.Str());
+		}
+	};
+}
@@ -0,0 +1,104 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+
+#include <vector>
+
+#include "String.hpp"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace MUtilsTest
+{
+	TEST_CLASS(MStringUTFTest)
+	{
+	public:
+		TEST_METHOD(ValidateRejectsIllFormedSequences)
+		{
+			char const* invalid[] = { "\x80", "\xC0\xAF", "\xC1\xBF", "\xE0\x80\xAF", "\xED\xA0\x80", "\xF0\x80\x80\x80",
+				"\xF4\x90\x80\x80", "\xF5\x80\x80\x80", "\xE2\x82", "\xFF", "a\xC3" };
+			for (char const* str : invalid)
+				Assert::IsFalse(MStringUTF::ValidateUTF8(str, (unsigned int)strlen(str)));
+			char const* valid[] = { "", "ascii", "\xC3\xA9", "\xE2\x82\xAC", "\xED\x9F\xBF", "\xEE\x80\x80", "\xF0\x9F\x98\x80", "\xF4\x8F\xBF\xBF" };
+			for (char const* str : valid)
+				Assert::IsTrue(MStringUTF::ValidateUTF8(str, (unsigned int)strlen(str)));
+		}
+
+		TEST_METHOD(OneReplacementPerMaximalSubpart)
+		{
+			Assert::AreEqual(3u, replacements("\xF0\x80\x80"));
+			Assert::AreEqual(1u, replacements("\xF0\x9F\x98"));
+			Assert::AreEqual(1u, replacements("\xE2\x82"));
+			Assert::AreEqual(3u, replacements("\xED\xA0\x80"));
+			Assert::AreEqual(2u, replacements("\xC0\xAF"));
+			Assert::AreEqual(2u, replacements("\x80\x80"));
+			std::vector<char32_t> decoded = toUTF32("a\xE2\x82" "b");
+			Assert::AreEqual((size_t)3, decoded.size());
+			Assert::IsTrue(decoded[0] == U'a' && decoded[1] == 0xFFFD && decoded[2] == U'b');
+		}
+
+		TEST_METHOD(EveryCodePointRoundTrips)
+		{
+			std::vector<char32_t> codePoints;
+			for (char32_t codePoint = 0; codePoint <= 0x10FFFF; ++codePoint)
+			{
+				if (codePoint < 0xD800 || codePoint > 0xDFFF)
+					codePoints.push_back(codePoint);
+			}
+			unsigned int		utf8Count = MStringUTF::UTF8Length(codePoints.data(), (unsigned int)codePoints.size());
+			std::vector<char>	utf8(utf8Count);
+			Assert::AreEqual(utf8Count, MStringUTF::UTF32ToUTF8(codePoints.data(), (unsigned int)codePoints.size(), utf8.data()));
+			Assert::IsTrue(MStringUTF::ValidateUTF8(utf8.data(), utf8Count));
+
+			std::vector<char16_t> utf16(MStringUTF::UTF16Length(utf8.data(), utf8Count));
+			MStringUTF::UTF8ToUTF16(utf8.data(), utf8Count, utf16.data());
+			std::vector<char> back(MStringUTF::UTF8Length(utf16.data(), (unsigned int)utf16.size()));
+			MStringUTF::UTF16ToUTF8(utf16.data(), (unsigned int)utf16.size(), back.data());
+			Assert::IsTrue(back == utf8);
+
+			std::vector<char32_t> utf32(MStringUTF::UTF32Length(utf8.data(), utf8Count));
+			MStringUTF::UTF8ToUTF32(utf8.data(), utf8Count, utf32.data());
+			Assert::IsTrue(utf32 == codePoints);
+		}
+
+		TEST_METHOD(LoneSurrogatesBecomeReplacement)
+		{
+			char16_t const	utf16[] = { u'a', 0xD800, u'b', 0xDC00, 0xD83D, 0xDE00, 0xDBFF };
+			unsigned int	count = MStringUTF::UTF8Length(utf16, 7);
+			std::vector<char> utf8(count);
+			MStringUTF::UTF16ToUTF8(utf16, 7, utf8.data());
+			Assert::IsTrue(MStringView(utf8.data(), count) == "a\xEF\xBF\xBD" "b\xEF\xBF\xBD\xF0\x9F\x98\x80\xEF\xBF\xBD");
+
+			char32_t const outOfRange[] = { 0xD800, 0x110000 };
+			Assert::AreEqual(6u, MStringUTF::UTF8Length(outOfRange, 2));
+		}
+
+		TEST_METHOD(LongMixedTextThroughWideStrings)
+		{
+			MString text;
+			for (unsigned int idx = 0; idx < 100; ++idx)
+				text += idx % 10 == 0 ? MStringView("\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80") : MStringView("plain ascii run ");
+			MWString	wide = MWString::FromString(text);
+			MString		back = wide.ToUTF8String();
+			Assert::IsTrue(back == text);
+			Assert::AreEqual(0u, MWString::FromUTF8("").Count());
+			Assert::AreEqual(0u, MWString(L"").ToUTF8String().Count());
+		}
+
+	private:
+		static auto	toUTF32(char const* str) -> std::vector<char32_t>
+		{
+			unsigned int			count = (unsigned int)strlen(str);
+			std::vector<char32_t>	out(MStringUTF::UTF32Length(str, count));
+			MStringUTF::UTF8ToUTF32(str, count, out.data());
+			return out;
+		}
+
+		static auto	replacements(char const* str) -> unsigned int
+		{
+			unsigned int res = 0;
+			for (char32_t codePoint : toUTF32(str))
+				res += codePoint == 0xFFFD;
+			return res;
+		}
+	};
+}
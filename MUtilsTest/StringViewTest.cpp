@@ -0,0 +1,102 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+
+#include "String.hpp"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace MUtilsTest
+{
+	TEST_CLASS(MStringViewTest)
+	{
+	public:
+		TEST_METHOD(SplitAllKeepsEmptyParts)
+		{
+			std::vector<MStringView> tokens;
+			Assert::AreEqual(5u, MStringView(",a,,b,").SplitAll(",", tokens));
+			Assert::IsTrue(tokens[0] == "" && tokens[1] == "a" && tokens[2] == "" && tokens[3] == "b" && tokens[4] == "");
+
+			Assert::AreEqual(1u, MStringView("").SplitAll(",", tokens));
+			Assert::IsTrue(tokens[0].IsEmpty());
+
+			Assert::AreEqual(3u, MStringView("a::b::").SplitAll("::", tokens));
+			Assert::IsTrue(tokens[0] == "a" && tokens[1] == "b" && tokens[2] == "");
+		}
+
+		TEST_METHOD(TokenizeSkipsEmptyParts)
+		{
+			std::vector<MStringView> tokens;
+			for (MStringView token : MStringView("  a b   c ").Tokenize(" ", true))
+				tokens.push_back(token);
+			Assert::AreEqual((size_t)3, tokens.size());
+			Assert::IsTrue(tokens[0] == "a" && tokens[1] == "b" && tokens[2] == "c");
+
+			unsigned int count = 0;
+			for (MStringView token : MStringView(",,,").Tokenize(",", true))
+			{
+				(void)token;
+				++count;
+			}
+			Assert::AreEqual(0u, count);
+		}
+
+		TEST_METHOD(TokenizeEmptySeparatorYieldsWholeText)
+		{
+			std::vector<MStringView> tokens;
+			Assert::AreEqual(1u, MStringView("abc").SplitAll("", tokens));
+			Assert::IsTrue(tokens[0] == "abc");
+		}
+
+		TEST_METHOD(SplitPointsIntoSource)
+		{
+			MString str("key=value=more");
+			MStringView left;
+			MStringView right;
+			Assert::IsTrue(str.Split("=", left, right));
+			Assert::IsTrue(left.Data() == str.Str());
+			Assert::IsTrue(left == "key");
+			Assert::IsTrue(right == "value=more");
+			Assert::IsFalse(str.Split(";", left, right));
+		}
+
+		TEST_METHOD(SubstrClampsToEnd)
+		{
+			MStringView view("abcdef");
+			Assert::IsTrue(view.Substr(2) == "cdef");
+			Assert::IsTrue(view.Substr(4, 100) == "ef");
+			Assert::IsTrue(view.Substr(100).IsEmpty());
+			Assert::IsTrue(view.Substr(6, 1).Data() == view.Data() + 6);
+		}
+
+		TEST_METHOD(ViewIsNotTerminated)
+		{
+			char const text[] = "abcdef";
+			MStringView view(text, 3);
+			Assert::IsTrue(view == "abc");
+			Assert::IsTrue(view != "abcdef");
+			Assert::IsTrue(view.Find('d') == MStringView::Npos);
+			Assert::IsTrue(view.Find("cd") == MStringView::Npos);
+			Assert::AreEqual("abc", MString(view).Str());
+		}
+
+		TEST_METHOD(TrimAndAffixes)
+		{
+			MStringView view(" \t\r\nvalue \v\f");
+			Assert::IsTrue(view.Trim() == "value");
+			Assert::IsTrue(view.TrimStart() == "value \v\f");
+			Assert::IsTrue(MStringView("   ").Trim().IsEmpty());
+			Assert::IsTrue(MStringView("file.mesh").StartsWith("file"));
+			Assert::IsTrue(MStringView("file.mesh").EndsWith(".mesh"));
+			Assert::IsFalse(MStringView("mesh").EndsWith("file.mesh"));
+			Assert::IsTrue(MStringView("").StartsWith(""));
+		}
+
+		TEST_METHOD(Ordering)
+		{
+			Assert::IsTrue(MStringView("abc") < MStringView("abd"));
+			Assert::IsTrue(MStringView("ab") < MStringView("abc"));
+			Assert::IsFalse(MStringView("abc") < MStringView("abc"));
+			Assert::IsTrue(MStringView("\x7f") < MStringView("\x80"));
+		}
+	};
+}
@@ -0,0 +1,239 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+#include "Strings/SubstringIndex.hpp"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace MUtilsTest
+{
+	TEST_CLASS(MSubstringIndexTest)
+	{
+	public:
+		TEST_METHOD(SuffixOrderMatchesNaiveSort)
+		{
+			srand(23);
+			for (unsigned int round = 0; round < 30; ++round)
+			{
+				MSubstringIndex				index;
+				std::vector<std::string>	documents = randomDocuments(1 + rand() % 4, round % 3 ? "ab" : "abc\xff");
+				std::string					text = addAll(index, documents);
+				index.Build();
+
+				std::vector<unsigned int> expected;
+				for (unsigned int pos = 0; pos < text.size(); ++pos)
+					expected.push_back(pos);
+				std::sort(expected.begin(), expected.end(), [&text](unsigned int first, unsigned int second) { return text.compare(first, std::string::npos, text, second, std::string::npos) < 0; });
+
+				//Suffixes starting with the same char are reported in suffix array order
+				std::vector<unsigned int> found;
+				for (unsigned int c = 1; c < 256; ++c)
+				{
+					char pattern = (char)c;
+					index.Locate(MStringView(&pattern, 1), [&](MSubstringIndex::Match const& match)
+					{
+						found.push_back(offsetOf(documents, match));
+						return true;
+					});
+				}
+				expected.erase(std::remove_if(expected.begin(), expected.end(), [&text](unsigned int pos) { return text[pos] == '\0'; }), expected.end());
+				Assert::IsTrue(found == expected);
+			}
+		}
+
+		TEST_METHOD(CountAndFindAllMatchNaiveSearch)
+		{
+			srand(24);
+			MSubstringIndex				index;
+			std::vector<std::string>	documents = randomDocuments(5, "abc");
+			addAll(index, documents);
+			index.Build(4);
+			for (unsigned int round = 0; round < 500; ++round)
+			{
+				std::string pattern;
+				for (unsigned int length = 1 + rand() % 6; pattern.size() < length; )
+					pattern += "abcd"[rand() % 4];
+				std::vector<MSubstringIndex::Match> expected;
+				for (unsigned int document = 0; document < documents.size(); ++document)
+				{
+					for (size_t pos = documents[document].find(pattern); pos != std::string::npos; pos = documents[document].find(pattern, pos + 1))
+						expected.push_back(MSubstringIndex::Match{ document, (unsigned int)pos });
+				}
+				std::vector<MSubstringIndex::Match> found;
+				Assert::AreEqual((unsigned int)expected.size(), index.Count(MStringView(pattern)));
+				Assert::AreEqual((unsigned int)expected.size(), index.FindAll(MStringView(pattern), found));
+				for (unsigned int idx = 0; idx < expected.size(); ++idx)
+					Assert::IsTrue(found[idx].Document == expected[idx].Document && found[idx].Offset == expected[idx].Offset);
+			}
+		}
+
+		TEST_METHOD(PatternsDoNotCrossDocuments)
+		{
+			MSubstringIndex index;
+			index.AddDocument("abc");
+			index.AddDocument("def");
+			index.AddDocument("");
+			index.Build();
+			Assert::AreEqual(0u, index.Count("cd"));
+			Assert::AreEqual(0u, index.Count(""));
+			Assert::AreEqual(1u, index.Count("def"));
+			Assert::AreEqual(0u, index.Count("defg"));
+			Assert::IsTrue(index.Document(1) == "def");
+			Assert::IsTrue(index.Document(2) == "");
+		}
+
+		TEST_METHOD(LongestRepeat)
+		{
+			MSubstringIndex index;
+			index.AddDocument("xabcdeyabcdz");
+			index.AddDocument("qqq");
+			index.Build();
+			Assert::IsTrue(index.LongestRepeat() == "abcd");
+			index.AddDocument("zabcdef");
+			Assert::IsFalse(index.IsBuilt());
+			Assert::AreEqual(0u, index.Count("abcd"));
+			index.Build();
+			Assert::IsTrue(index.LongestRepeat() == "abcde");
+
+			MSubstringIndex unique;
+			unique.AddDocument("abc");
+			unique.Build();
+			Assert::IsTrue(unique.LongestRepeat().IsEmpty());
+		}
+
+		TEST_METHOD(SaveAndLoad)
+		{
+			srand(25);
+			MSubstringIndex				index;
+			std::vector<std::string>	documents = randomDocuments(3, "abc");
+			addAll(index, documents);
+			index.Build();
+			Assert::IsTrue(index.Save("MSubstringIndexTest.bin"));
+			{
+				MSubstringIndex loaded;
+				Assert::IsTrue(loaded.Load("MSubstringIndexTest.bin"));
+				Assert::AreEqual(3u, loaded.DocumentCount());
+				Assert::IsTrue(loaded.Document(2) == MStringView(documents[2]));
+				char const* patterns[] = { "a", "ab", "cab", "bbb", "abcabc" };
+				for (char const* pattern : patterns)
+					Assert::AreEqual(index.Count(pattern), loaded.Count(pattern));
+				Assert::IsTrue(loaded.LongestRepeat() == index.LongestRepeat());
+			}
+			std::remove("MSubstringIndexTest.bin");
+		}
+
+		TEST_METHOD(DamagedFiles)
+		{
+			MSubstringIndex index;
+			index.AddDocument("banana");
+			index.AddDocument("bandana");
+			index.Build();
+			Assert::IsTrue(index.Verify());
+			Assert::IsTrue(index.Save("MSubstringIndexDamaged.bin"));
+			std::vector<char> good = readFile("MSubstringIndexDamaged.bin");
+
+			//Header, text padded to 4 bytes, 3 document starts, 15 suffixes then 15 LCP values
+			unsigned int	header = 32;
+			unsigned int	startsAt = header + 16;
+			unsigned int	suffixesAt = startsAt + 3 * 4;
+			unsigned int	lcpsAt = suffixesAt + 15 * 4;
+
+			//Load only reads the header, the sizes and both ends of the text and of the document starts
+			unsigned int	rejected[][2] = { { startsAt, 1 }, { startsAt + 8, 14 }, { header + 12, 0x61616161 }, { 8, 16 }, { 4, 2 } };
+			for (auto const& damage : rejected)
+			{
+				writeFile("MSubstringIndexDamaged.bin", damaged(good, damage[0], damage[1]));
+				MSubstringIndex loaded;
+				Assert::IsFalse(loaded.Load("MSubstringIndexDamaged.bin"));
+				Assert::AreEqual(0u, loaded.Count("an"));
+			}
+			writeFile("MSubstringIndexDamaged.bin", std::vector<char>(good.begin(), good.begin() + 40));
+			Assert::IsFalse(MSubstringIndex().Load("MSubstringIndexDamaged.bin"));
+
+			//Damaged entries are found by Verify, queries stay in bounds until then
+			unsigned int	loadedDamages[][2] = { { startsAt + 4, 100 }, { startsAt + 4, 3 }, { suffixesAt + 8, 15 }, { suffixesAt, 0xFFFFFFF0 }, { lcpsAt + 4, 15 }, { lcpsAt + 8, 0xFFFFFFFF } };
+			for (auto const& damage : loadedDamages)
+			{
+				writeFile("MSubstringIndexDamaged.bin", damaged(good, damage[0], damage[1]));
+				MSubstringIndex loaded;
+				Assert::IsTrue(loaded.Load("MSubstringIndexDamaged.bin"));
+				Assert::IsFalse(loaded.Verify());
+				std::vector<MSubstringIndex::Match> matches;
+				char const* patterns[] = { "a", "an", "ban", "nana", "dana\xff" };
+				for (char const* pattern : patterns)
+				{
+					loaded.Count(pattern);
+					loaded.FindAll(pattern, matches);
+				}
+				Assert::IsTrue(loaded.LongestRepeat().Count() <= 15);
+				Assert::IsTrue(loaded.Document(0).Count() <= 15 && loaded.Document(1).Count() <= 15);
+			}
+
+			writeFile("MSubstringIndexDamaged.bin", good);
+			MSubstringIndex loaded;
+			Assert::IsTrue(loaded.Load("MSubstringIndexDamaged.bin"));
+			Assert::IsTrue(loaded.Verify());
+			Assert::AreEqual(4u, loaded.Count("an"));
+			std::remove("MSubstringIndexDamaged.bin");
+		}
+
+	private:
+		static auto	randomDocuments(unsigned int count, char const* alphabet) -> std::vector<std::string>
+		{
+			std::vector<std::string> documents(count);
+			for (std::string& document : documents)
+			{
+				unsigned int length = rand() % 300;
+				for (unsigned int idx = 0; idx < length; ++idx)
+					document += alphabet[rand() % strlen(alphabet)];
+			}
+			return documents;
+		}
+
+		//Adds the documents and returns the indexed text, every document followed by a '\0'
+		static auto	addAll(MSubstringIndex& index, std::vector<std::string> const& documents) -> std::string
+		{
+			std::string text;
+			for (std::string const& document : documents)
+			{
+				index.AddDocument(MStringView(document));
+				text += document;
+				text += '\0';
+			}
+			return text;
+		}
+
+		static auto	offsetOf(std::vector<std::string> const& documents, MSubstringIndex::Match const& match) -> unsigned int
+		{
+			unsigned int offset = match.Offset;
+			for (unsigned int idx = 0; idx < match.Document; ++idx)
+				offset += (unsigned int)documents[idx].size() + 1;
+			return offset;
+		}
+
+		static auto	readFile(char const* path) -> std::vector<char>
+		{
+			std::ifstream in(path, std::ios::binary);
+			return std::vector<char>(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+		}
+
+		static auto	damaged(std::vector<char> content, unsigned int at, unsigned int value) -> std::vector<char>
+		{
+			memcpy(content.data() + at, &value, 4);
+			return content;
+		}
+
+		static auto	writeFile(char const* path, std::vector<char> const& content) -> void
+		{
+			std::ofstream out(path, std::ios::binary | std::ios::trunc);
+			out.write(content.data(), content.size());
+		}
+	};
+}
@@ -0,0 +1,102 @@
+#include "stdafx.h"
+#include "CppUnitTest.h"
+
+#include <cstdlib>
+
+#include "Strings/TextBuffer.hpp"
+
+using namespace Microsoft::VisualStudio::CppUnitTestFramework;
+
+namespace MUtilsTest
+{
+	TEST_CLASS(MTextBufferTest)
+	{
+	public:
+		TEST_METHOD(RandomEditsMatchString)
+		{
+			srand(21);
+			MTextBuffer	buffer;
+			std::string	expected;
+			for (unsigned int round = 0; round < 20000; ++round)
+			{
+				unsigned int idx = rand() % (expected.size() + 1);
+				switch (rand() % 4)
+				{
+				case 0:
+				{
+					std::string text(rand() % 20, (char)('a' + round % 26));
+					buffer.InsertAt(idx, MStringView(text));
+					expected.insert(idx, text);
+					break;
+				}
+				case 1:
+					buffer.InsertAt(idx, '#');
+					expected.insert(expected.begin() + idx, '#');
+					break;
+				case 2:
+				{
+					unsigned int size = rand() % 15;
+					buffer.RemoveAt(idx, size);
+					if (idx + size <= expected.size())
+						expected.erase(idx, size);
+					break;
+				}
+				default:
+					buffer += "tail";
+					expected += "tail";
+					break;
+				}
+				Assert::AreEqual((unsigned int)expected.size(), buffer.Count());
+				if (round % 500 == 0)
+					Assert::IsTrue(buffer.ToString() == MStringView(expected));
+			}
+			for (unsigned int idx = 0; idx < expected.size(); idx += 97)
+				Assert::AreEqual(expected[idx], buffer[idx]);
+			Assert::IsTrue(buffer.View() == MStringView(expected));
+		}
+
+		TEST_METHOD(OutOfRangeEditsDoNothing)
+		{
+			MTextBuffer buffer;
+			buffer.InsertAt(1, "x");
+			Assert::AreEqual(0u, buffer.Count());
+			buffer.Append("abc");
+			buffer.RemoveAt(2, 2);
+			buffer.InsertAt(4, 'y');
+			Assert::IsTrue(buffer.View() == "abc");
+			buffer.RemoveAt(3, 0);
+			buffer.InsertAt(3, "");
+			Assert::IsTrue(buffer.View() == "abc");
+		}
+
+		TEST_METHOD(InsertViewsOfItself)
+		{
+			MTextBuffer buffer;
+			buffer.Append("0123456789");
+			buffer.InsertAt(5, "|");
+			buffer.InsertAt(0, buffer.Front());
+			buffer.InsertAt(buffer.Count(), buffer.Back());
+			Assert::IsTrue(buffer.View() == "01234|01234|5678901234|56789");
+			buffer.InsertAt(2, buffer.View());
+			Assert::IsTrue(buffer.View() == "0101234|01234|5678901234|56789234|01234|5678901234|56789");
+		}
+
+		TEST_METHOD(ReadAcrossGap)
+		{
+			MTextBuffer buffer;
+			buffer.Append("hello world");
+			buffer.InsertAt(5, ",");
+			Assert::IsTrue(buffer.Front() == "hello,");
+			Assert::IsTrue(buffer.Back() == " world");
+			Assert::IsTrue(buffer.Substr(3, 6) == "lo, wo");
+			Assert::IsTrue(buffer.Substr(10) == "ld");
+			Assert::IsTrue(buffer.Substr(50).Count() == 0);
+			char text[8];
+			Assert::AreEqual(7u, buffer.CopyTo(text, sizeof(text)));
+			Assert::IsTrue(MStringView(text) == "hello, ");
+			buffer.Clear();
+			Assert::AreEqual(0u, buffer.Count());
+			Assert::IsTrue(buffer.View() == "");
+		}
+	};
+}
@@ -0,0 +1,1037 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <new>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "Benchmark.hpp"
+#include "../MUtils/String.hpp"
+#include "../MUtils/Strings/Glob.hpp"
+#include "../MUtils/Strings/MappedFile.hpp"
+#include "../MUtils/Strings/RadixTrie.hpp"
+#include "../MUtils/Strings/StringBuilder.hpp"
+#include "../MUtils/Strings/StringMatcher.hpp"
+#include "../MUtils/Strings/StringSort.hpp"
+#include "../MUtils/Strings/StringTable.hpp"
+#include "../MUtils/Strings/SubstringIndex.hpp"
+#include "../MUtils/Strings/TextBuffer.hpp"
+#include "../MUtils/Maths/Vector.hpp"
+
+//Atomic since the arena benchmark allocates from several threads
+static std::atomic<unsigned long long>	allocationCount(0);
+
+void*	operator new(size_t size)
+{
+	++allocationCount;
+	if (void* ptr = malloc(size ? size : 1))
+		return ptr;
+	throw std::bad_alloc();
+}
+
+void*	operator new[](size_t size) { return operator new(size); }
+void	operator delete(void* ptr) noexcept { free(ptr); }
+void	operator delete[](void* ptr) noexcept { free(ptr); }
+//Sized forms picked by C++14 compilers when the size is known, they must free as well
+void	operator delete(void* ptr, size_t) noexcept { free(ptr); }
+void	operator delete[](void* ptr, size_t) noexcept { free(ptr); }
+
+class BenchTimer
+{
+public:
+	BenchTimer(const char* name) : name(name), allocations(allocationCount), start(std::chrono::high_resolution_clock::now()) {}
+	~BenchTimer()
+	{
+		auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::high_resolution_clock::now() - start);
+		std::cout << name << ": " << elapsed.count() << "us, " << allocationCount - allocations << " allocations" << std::endl;
+	}
+
+private:
+	const char*										name;
+	unsigned long long								allocations;
+	std::chrono::high_resolution_clock::time_point	start;
+};
+
+static const int	iterations = 100000;
+
+auto	BenchStringAllocations() -> void
+{
+	const char* tags[] = { "id", "asset_tag_0042", "log.field.timestamp", "a/much/longer/path/that/does/not/fit/inline" };
+
+	for (const char* tag : tags)
+	{
+		std::cout << "-- \"" << tag << "\" (" << strlen(tag) << " chars)" << std::endl;
+		{
+			BenchTimer	timer("MString copy + append");
+			for (int i = 0; i < iterations; ++i)
+			{
+				MString str(tag);
+				MString copy(str);
+				copy.Append('_');
+			}
+		}
+		{
+			BenchTimer	timer("std::string copy + append");
+			for (int i = 0; i < iterations; ++i)
+			{
+				std::string str(tag);
+				std::string copy(str);
+				copy += '_';
+			}
+		}
+	}
+
+	{
+		BenchTimer	timer("MString default + Empty");
+		for (int i = 0; i < iterations; ++i)
+		{
+			MString str;
+			str.Empty();
+		}
+	}
+}
+
+auto	BenchStringAppend() -> void
+{
+	{
+		BenchTimer	timer("MString append char by char");
+		MString str;
+		for (int i = 0; i < iterations; ++i)
+			str.Append('x');
+	}
+	{
+		BenchTimer	timer("MString append after Reserve");
+		MString str;
+		str.Reserve(iterations);
+		for (int i = 0; i < iterations; ++i)
+			str.Append('x');
+	}
+	{
+		BenchTimer	timer("std::string append char by char");
+		std::string str;
+		for (int i = 0; i < iterations; ++i)
+			str += 'x';
+	}
+}
+
+auto	BenchStringBuilder() -> void
+{
+	const int	lines = 10000;
+	const char*	field = "level=info module=renderer ";
+
+	{
+		BenchTimer	timer("MString operator+ chain");
+		MString report;
+		for (int i = 0; i < lines; ++i)
+			report = report + field + MString::FromInt(i) + '\n';
+	}
+	{
+		//Each line is a single allocation, the operands are only written once
+		BenchTimer	timer("MString a + b + c + d");
+		MString		module("renderer");
+		unsigned int total = 0;
+		for (int i = 0; i < lines; ++i)
+		{
+			MString line = field + module + " frame=" + MString::FromInt(i) + " status=ok" + '\n';
+			total += line.Count();
+		}
+		std::cout << total << std::endl;
+	}
+	{
+		BenchTimer	timer("std::string a + b + c + d");
+		std::string	module("renderer");
+		unsigned int total = 0;
+		for (int i = 0; i < lines; ++i)
+		{
+			std::string line = field + module + " frame=" + std::to_string(i) + " status=ok" + '\n';
+			total += (unsigned int)line.size();
+		}
+		std::cout << total << std::endl;
+	}
+	{
+		BenchTimer	timer("MStringBuilder");
+		MStringBuilder builder;
+		for (int i = 0; i < lines; ++i)
+			builder.Append(field).AppendInt(i).Append('\n');
+		MString report = builder.ToString();
+	}
+	{
+		BenchTimer	timer("std::string + reserve");
+		std::string report;
+		report.reserve(lines * 40);
+		for (int i = 0; i < lines; ++i)
+		{
+			report += field;
+			report += std::to_string(i);
+			report += '\n';
+		}
+	}
+}
+
+auto	BenchStringSearch() -> void
+{
+	const unsigned int	sizes[] = { 1024, 64 * 1024, 1024 * 1024 };
+	const char*			needle = "needle_in_the_haystack";
+
+	for (unsigned int size : sizes)
+	{
+		MString hay;
+		hay.Reserve(size);
+		for (unsigned int idx = 0; hay.Count() + 32 < size; ++idx)
+			hay.Append("needle_in_the_haybale "[idx % 22]);
+		hay.Append(needle);
+		MString other(hay);
+
+		//Read back through a volatile each time so the compiler cannot hoist the searches out of the loops
+		char const* volatile	source = hay.Str();
+		int						repeat = (int)(64 * 1024 * 1024 / size);
+		unsigned int			found = 0;
+		std::cout << "-- haystack of " << hay.Count() << " bytes, " << repeat << " searches" << std::endl;
+		{
+			BenchTimer	timer("strstr");
+			for (int i = 0; i < repeat; ++i)
+				found += strstr(source, needle) != nullptr;
+		}
+		{
+			BenchTimer	timer("MStringView::Find");
+			for (int i = 0; i < repeat; ++i)
+				found += MStringView(source, hay.Count()).Find(needle) != MStringView::Npos;
+		}
+		{
+			BenchTimer	timer("strcmp equal");
+			for (int i = 0; i < repeat; ++i)
+				found += strcmp(source, other.Str()) == 0;
+		}
+		{
+			BenchTimer	timer("MStringView::operator== equal");
+			for (int i = 0; i < repeat; ++i)
+				found += MStringView(source, hay.Count()) == other;
+		}
+		std::cout << found << " matches" << std::endl;
+	}
+}
+
+auto	BenchStringNumbers() -> void
+{
+	char			buffer[64];
+	unsigned int	total = 0;
+	{
+		BenchTimer	timer("snprintf %d");
+		for (int i = 0; i < iterations; ++i)
+			total += snprintf(buffer, sizeof(buffer), "%d", i * 7919 - 400000);
+	}
+	{
+		BenchTimer	timer("MStringNumber::FormatInt");
+		for (int i = 0; i < iterations; ++i)
+			total += MStringNumber::FormatInt(buffer, i * 7919 - 400000);
+	}
+	{
+		BenchTimer	timer("snprintf %.9g");
+		for (int i = 0; i < iterations; ++i)
+			total += snprintf(buffer, sizeof(buffer), "%.9g", (float)i * 0.37f);
+	}
+	{
+		BenchTimer	timer("MStringNumber::FormatFloat");
+		for (int i = 0; i < iterations; ++i)
+			total += MStringNumber::FormatFloat(buffer, (float)i * 0.37f);
+	}
+
+	MString	values;
+	for (int i = 0; i < 1000; ++i)
+	{
+		values.AppendFloat((float)i * 0.37f);
+		values.Append(' ');
+	}
+	float	sum = 0.0f;
+	{
+		BenchTimer	timer("strtof");
+		for (int i = 0; i < iterations / 1000; ++i)
+		{
+			for (char* pos = (char*)values.Str(); *pos; ++pos)
+				sum += strtof(pos, &pos);
+		}
+	}
+	{
+		BenchTimer	timer("MStringView::ParseFloat");
+		for (int i = 0; i < iterations / 1000; ++i)
+		{
+			MStringView		rest(values);
+			float			value;
+			while (unsigned int used = rest.ParseFloat(value))
+			{
+				sum += value;
+				rest = rest.Substr(used + 1);
+			}
+		}
+	}
+	std::cout << total << " chars, sum " << sum << std::endl;
+}
+
+auto	BenchStringHash() -> void
+{
+	//Collisions of the 32 low bits on similar keys, about n^2 / 2^33 are expected from a uniform hash
+	const unsigned int		keyCount = 1 << 20;
+	std::vector<unsigned int>	low;
+	low.reserve(keyCount);
+	MString	key;
+	for (unsigned int idx = 0; idx < keyCount; ++idx)
+	{
+		key = "entity/";
+		key.AppendUInt(idx);
+		low.push_back((unsigned int)key.Hash());
+	}
+	std::sort(low.begin(), low.end());
+	unsigned int collisions = 0;
+	for (unsigned int idx = 1; idx < keyCount; ++idx)
+		collisions += low[idx] == low[idx - 1];
+	std::cout << "-- " << keyCount << " keys, " << collisions << " low 32 bits collisions (" << (double)keyCount * keyCount / 8589934592.0 << " expected)" << std::endl;
+
+	const unsigned int	sizes[] = { 8, 32, 256, 64 * 1024 };
+	for (unsigned int size : sizes)
+	{
+		std::string				text(size, 'h');
+		char const* volatile	source = text.data();
+		int						repeat = (int)(256 * 1024 * 1024 / (size + 16));
+		unsigned long long		sum = 0;
+		std::cout << "-- " << size << " bytes, " << repeat << " hashes" << std::endl;
+		{
+			BenchTimer	timer("std::hash<std::string>");
+			std::hash<std::string>	hasher;
+			for (int i = 0; i < repeat; ++i)
+			{
+				text[0] = (char)i;
+				sum += hasher(text);
+			}
+		}
+		{
+			BenchTimer	timer("MStringHash::Hash");
+			for (int i = 0; i < repeat; ++i)
+			{
+				text[0] = (char)i;
+				sum += MStringHash::Hash(source, size);
+			}
+		}
+		std::cout << sum << std::endl;
+	}
+
+	std::unordered_map<MString, int>	hashed;
+	std::map<MString, int>				ordered;
+	std::vector<MString>				keys;
+	for (int idx = 0; idx < 10000; ++idx)
+	{
+		key = "asset/textures/";
+		key.AppendInt(idx * 7919);
+		hashed[key] = idx;
+		ordered[key] = idx;
+		keys.push_back(key);
+	}
+	long long found = 0;
+	{
+		BenchTimer	timer("std::map<MString> lookup");
+		for (int i = 0; i < iterations; ++i)
+			found += ordered.find(keys[i % keys.size()])->second;
+	}
+	{
+		BenchTimer	timer("std::unordered_map<MString> lookup");
+		for (int i = 0; i < iterations; ++i)
+			found += hashed.find(keys[i % keys.size()])->second;
+	}
+	std::cout << found << std::endl;
+
+	//Dispatch on a command name: compare chain against a switch on the compile time hash
+	static_assert(MStringHash::Distinct("move"_mh, "jump"_mh, "crouch"_mh, "interact"_mh, "reload"_mh, "inventory"_mh, "map"_mh, "pause"_mh), "Command hashes collide");
+	MString const	commands[] = { MString("move"), MString("jump"), MString("crouch"), MString("interact"), MString("reload"), MString("inventory"), MString("map"), MString("pause") };
+	int				dispatched = 0;
+	{
+		BenchTimer	timer("if chain dispatch");
+		for (int i = 0; i < iterations; ++i)
+		{
+			MString const& command = commands[i & 7];
+			if (command == "move") dispatched += 1;
+			else if (command == "jump") dispatched += 2;
+			else if (command == "crouch") dispatched += 3;
+			else if (command == "interact") dispatched += 4;
+			else if (command == "reload") dispatched += 5;
+			else if (command == "inventory") dispatched += 6;
+			else if (command == "map") dispatched += 7;
+			else if (command == "pause") dispatched += 8;
+		}
+	}
+	{
+		BenchTimer	timer("switch on _mh dispatch");
+		for (int i = 0; i < iterations; ++i)
+		{
+			MString const& command = commands[i & 7];
+			switch (command.Hash())
+			{
+			case "move"_mh: dispatched += command == "move" ? 1 : 0; break;
+			case "jump"_mh: dispatched += command == "jump" ? 2 : 0; break;
+			case "crouch"_mh: dispatched += command == "crouch" ? 3 : 0; break;
+			case "interact"_mh: dispatched += command == "interact" ? 4 : 0; break;
+			case "reload"_mh: dispatched += command == "reload" ? 5 : 0; break;
+			case "inventory"_mh: dispatched += command == "inventory" ? 6 : 0; break;
+			case "map"_mh: dispatched += command == "map" ? 7 : 0; break;
+			case "pause"_mh: dispatched += command == "pause" ? 8 : 0; break;
+			}
+		}
+	}
+	std::cout << dispatched << std::endl;
+}
+
+//Builds the debug text of a frame, allocator is nullptr for the heap
+static auto	buildFrameText(MStringAllocator* allocator, int frame) -> unsigned int
+{
+	unsigned int total = 0;
+	for (int entity = 0; entity < 100; ++entity)
+	{
+		MString text(allocator);
+		text += "entity ";
+		text.AppendInt(entity);
+		text += " frame ";
+		text.AppendInt(frame);
+		text += " position ";
+		text.AppendFloat(entity * 0.5f);
+		MString key(allocator);
+		key = text + "/debug";
+		total += key.Count();
+	}
+	return total;
+}
+
+auto	BenchStringArena() -> void
+{
+	const int		frames = iterations / 100;
+	const int		threadCount = 4;
+	unsigned int	total = 0;
+	{
+		BenchTimer	timer("heap frame strings");
+		for (int frame = 0; frame < frames; ++frame)
+			total += buildFrameText(nullptr, frame);
+	}
+	{
+		BenchTimer		timer("arena frame strings");
+		MStringArena	arena;
+		for (int frame = 0; frame < frames; ++frame)
+		{
+			total += buildFrameText(&arena, frame);
+			arena.Reset();
+		}
+	}
+	{
+		BenchTimer					timer("heap frame strings, 4 threads");
+		std::vector<std::thread>	threads;
+		for (int idx = 0; idx < threadCount; ++idx)
+		{
+			threads.emplace_back([frames]()
+			{
+				for (int frame = 0; frame < frames; ++frame)
+					buildFrameText(nullptr, frame);
+			});
+		}
+		for (std::thread& thread : threads)
+			thread.join();
+	}
+	{
+		BenchTimer					timer("arena frame strings, 4 threads");
+		std::vector<std::thread>	threads;
+		for (int idx = 0; idx < threadCount; ++idx)
+		{
+			threads.emplace_back([frames]()
+			{
+				MStringArena	arena;
+				for (int frame = 0; frame < frames; ++frame)
+				{
+					buildFrameText(&arena, frame);
+					arena.Reset();
+				}
+			});
+		}
+		for (std::thread& thread : threads)
+			thread.join();
+	}
+	std::cout << total << " chars" << std::endl;
+}
+
+//Define MSTRING_SHARED_BUFFERS in the project to compare with shared buffers
+auto	BenchStringCopy() -> void
+{
+	std::string		text(4096, 'e');
+	MString			name(text.c_str());
+	unsigned int	total = 0;
+	std::cout << "-- 4096 chars, shared buffers " << (name.IsShared() || MString(name).IsShared() ? "on" : "off") << std::endl;
+	{
+		BenchTimer	timer("std::string copy");
+		for (int i = 0; i < iterations; ++i)
+		{
+			std::string copy(text);
+			total += (unsigned int)copy.size();
+		}
+	}
+	{
+		BenchTimer	timer("MString copy");
+		for (int i = 0; i < iterations; ++i)
+		{
+			MString copy(name);
+			total += copy.Count();
+		}
+	}
+	{
+		BenchTimer					timer("MString copy, 4 threads");
+		std::vector<std::thread>	threads;
+		for (int idx = 0; idx < 4; ++idx)
+		{
+			threads.emplace_back([&name]()
+			{
+				for (int i = 0; i < iterations; ++i)
+				{
+					MString copy(name);
+					if (copy.Count() != name.Count())
+						std::cout << "copy mismatch" << std::endl;
+				}
+			});
+		}
+		for (std::thread& thread : threads)
+			thread.join();
+	}
+	std::cout << total << " chars" << std::endl;
+}
+
+auto	BenchStringUTF() -> void
+{
+	const char*	names[] = { "ascii", "mixed" };
+	const char*	samples[] = { "plain ascii log line with a few numbers 12345 and words ", u8"caf\u00e9 na\u00efve r\u00e9sum\u00e9 \u4e16\u754c \U0001F600 " };
+	for (int sampleIdx = 0; sampleIdx < 2; ++sampleIdx)
+	{
+		const char* sample = samples[sampleIdx];
+		MString text;
+		while (text.Count() < 64 * 1024)
+			text += sample;
+		unsigned long long	total = 0;
+		int					repeat = iterations / 1000;
+		std::cout << "-- " << text.Count() << " bytes of " << names[sampleIdx] << " text" << std::endl;
+		{
+			BenchTimer	timer("MStringUTF::ValidateUTF8");
+			for (int i = 0; i < repeat; ++i)
+				total += MStringUTF::ValidateUTF8(text.Str(), text.Count());
+		}
+		{
+			BenchTimer	timer("MWString::FromUTF8");
+			for (int i = 0; i < repeat; ++i)
+				total += MWString::FromUTF8(text).Count();
+		}
+		MWString wide = MWString::FromUTF8(text);
+		{
+			BenchTimer	timer("MWString::ToUTF8String");
+			for (int i = 0; i < repeat; ++i)
+				total += wide.ToUTF8String().Count();
+		}
+		std::cout << total << std::endl;
+	}
+}
+
+auto	BenchStringMatcher() -> void
+{
+	MString log;
+	for (unsigned int idx = 0; log.Count() < 1024 * 1024; ++idx)
+	{
+		log += "2024-01-01 12:00:00 INFO request handled in ";
+		log.AppendUInt(idx % 977);
+		log += "ms by worker ";
+		log.AppendUInt(idx % 13);
+		if (idx % 1000 == 0)
+			log += " secret_7919 Token:0";
+		log += '\n';
+	}
+
+	const unsigned int	counts[] = { 4, 100, 2000 };
+	for (unsigned int patternCount : counts)
+	{
+		std::vector<MString>	patterns;
+		MStringMatcher			matcher;
+		for (unsigned int idx = 0; idx < patternCount; ++idx)
+		{
+			MString pattern(idx % 2 ? "secret_" : "Token:");
+			pattern.AppendUInt(idx * 7919);
+			matcher.AddPattern(pattern);
+			patterns.push_back(pattern);
+		}
+		matcher.Build();
+		std::cout << "-- " << patternCount << " patterns, " << matcher.StateCount() << " states, " << log.Count() << " bytes" << std::endl;
+
+		unsigned int found = 0;
+		if (patternCount <= 100)
+		{
+			BenchTimer	timer("MString::Contains per pattern");
+			for (MString const& pattern : patterns)
+				found += log.Contains(pattern);
+		}
+		{
+			BenchTimer	timer("MStringMatcher::ContainsAny");
+			found += matcher.ContainsAny(log);
+		}
+		std::vector<MStringMatcher::Match>	matches;
+		{
+			BenchTimer	timer("MStringMatcher::FindAll");
+			found += matcher.FindAll(log, matches);
+		}
+		std::cout << found << " found" << std::endl;
+	}
+}
+
+auto	BenchStringFormat() -> void
+{
+	const int		count = iterations / 10;
+	unsigned int	total = 0;
+	{
+		BenchTimer	timer("std::string + std::to_string");
+		for (int i = 0; i < count; ++i)
+			total += (unsigned int)("request " + std::to_string(i) + " took " + std::to_string((float)i * 0.37f) + "ms").size();
+	}
+	{
+		BenchTimer	timer("snprintf");
+		char		buffer[64];
+		for (int i = 0; i < count; ++i)
+			total += snprintf(buffer, sizeof(buffer), "request %d took %gms", i, (float)i * 0.37f);
+	}
+	{
+		BenchTimer	timer("MString::Format");
+		for (int i = 0; i < count; ++i)
+			total += MString::Format(MFORMAT("request {} took {}ms"), i, (float)i * 0.37f).Count();
+	}
+	{
+		BenchTimer	timer("MStringBuilder::AppendFormat");
+		MStringBuilder	builder;
+		for (int i = 0; i < count; ++i)
+			builder.AppendFormat(MFORMAT("request {} took {}ms\n"), i, (float)i * 0.37f);
+		total += builder.Count();
+	}
+	Vector3F	position(1.5f, -2.25f, 1e-3f);
+	{
+		BenchTimer	timer("Vector3F::ToString");
+		for (int i = 0; i < count; ++i)
+			total += (unsigned int)position.ToString().size();
+	}
+	{
+		BenchTimer	timer("MString::Format Vector3F");
+		for (int i = 0; i < count; ++i)
+			total += MString::Format(MFORMAT("{}"), position).Count();
+	}
+	std::cout << total << std::endl;
+}
+
+auto	BenchStringReplace() -> void
+{
+	std::string	source;
+	for (unsigned int idx = 0; source.size() < 256 * 1024; ++idx)
+		source += "key_" + std::to_string(idx % 97) + "=value; ";
+	unsigned int total = 0;
+	{
+		BenchTimer	timer("std::string find + replace");
+		std::string	text = source;
+		for (size_t pos = text.find("value"); pos != std::string::npos; pos = text.find("value", pos + 4))
+			text.replace(pos, 5, "val");
+		total += (unsigned int)text.size();
+	}
+	{
+		BenchTimer	timer("MString::ReplaceAll shrinking");
+		MString		text{ MStringView(source) };
+		total += text.ReplaceAll("value", "val");
+	}
+	{
+		BenchTimer	timer("MString::ReplaceAll growing");
+		MString		text{ MStringView(source) };
+		total += text.ReplaceAll("value", "a longer value");
+	}
+
+	std::vector<MString>	parts;
+	for (unsigned int idx = 0; idx < 10000; ++idx)
+		parts.push_back(MString::FromUInt(idx));
+	{
+		BenchTimer	timer("MString operator+ join");
+		MString		joined;
+		for (MString const& part : parts)
+			joined = joined + part + ", ";
+		total += joined.Count();
+	}
+	{
+		BenchTimer	timer("MString::Join");
+		total += MString::Join(parts, ", ").Count();
+	}
+	std::cout << total << std::endl;
+}
+
+auto	BenchStringSort() -> void
+{
+	//Shared path like prefixes and random tails, long enough to live on the heap
+	std::vector<MString>	source;
+	unsigned int			seed = 12345;
+	for (unsigned int idx = 0; idx < 500000; ++idx)
+	{
+		seed = seed * 1103515245 + 12345;
+		MString key(idx % 3 ? "assets/textures/environment/" : "assets/meshes/");
+		key.AppendUInt(seed % 100000);
+		key += "_lod";
+		key.AppendUInt(seed % 7);
+		source.push_back(key);
+	}
+	bool sorted = true;
+	{
+		std::vector<MString>	strings = source;
+		BenchTimer				timer("std::sort");
+		std::sort(strings.begin(), strings.end(), [](MString const& first, MString const& second) { return first < second; });
+	}
+	{
+		std::vector<MString>	strings = source;
+		BenchTimer				timer("std::stable_sort");
+		std::stable_sort(strings.begin(), strings.end(), [](MString const& first, MString const& second) { return first < second; });
+	}
+	{
+		std::vector<MString>	strings = source;
+		{
+			BenchTimer	timer("MStringSort::Sort");
+			MStringSort::Sort(strings);
+		}
+		sorted &= std::is_sorted(strings.begin(), strings.end(), [](MString const& first, MString const& second) { return first < second; });
+	}
+	{
+		std::vector<MString>	strings = source;
+		BenchTimer				timer("MStringSort::StableSort");
+		MStringSort::StableSort(strings.data(), (unsigned int)strings.size());
+	}
+	{
+		std::vector<MString>	strings = source;
+		{
+			BenchTimer	timer("MStringSort::Sort all threads");
+			MStringSort::Sort(strings, MStringSort::AllThreads);
+		}
+		sorted &= std::is_sorted(strings.begin(), strings.end(), [](MString const& first, MString const& second) { return first < second; });
+	}
+	std::cout << (sorted ? "sorted" : "NOT SORTED") << std::endl;
+}
+
+auto	BenchMappedFile() -> void
+{
+	const char*	path = "bench_lines.txt";
+	{
+		MStringBuilder	builder;
+		for (unsigned int idx = 0; builder.Count() < 64 * 1024 * 1024; ++idx)
+			builder.AppendFormat(MFORMAT("2024-01-01 12:00:00 INFO request {} handled in {}ms\r\n"), idx, idx % 977);
+		MString	text = builder.ToString();
+		FILE*	file = fopen(path, "wb");
+		if (!file)
+			return;
+		fwrite(text.Str(), 1, text.Count(), file);
+		fclose(file);
+	}
+
+	unsigned long long total = 0;
+	{
+		BenchTimer		timer("std::ifstream + std::getline");
+		std::ifstream	stream(path, std::ios::binary);
+		std::string		line;
+		while (std::getline(stream, line))
+			total += line.size();
+	}
+	{
+		BenchTimer	timer("MMappedFile::Lines");
+		MMappedFile	file(path);
+		for (MStringView line : file.Lines())
+			total += line.Count();
+	}
+	{
+		BenchTimer	timer("MMappedFile::ReadAll + MStringLines");
+		MString		content;
+		if (MMappedFile::ReadAll(path, content))
+		{
+			for (MStringView line : MStringLines(content))
+				total += line.Count();
+		}
+	}
+	remove(path);
+	std::cout << total << std::endl;
+}
+
+auto	BenchTextBuffer() -> void
+{
+	//Typing session in the middle of a large file: the cursor wanders slowly, most keys insert and some erase
+	const unsigned int	size = 512 * 1024;
+	const int			edits = 20000;
+	std::string			source(size, 'x');
+	for (unsigned int idx = 63; idx < size; idx += 64)
+		source[idx] = '\n';
+	MStringView			text(source.data(), size);
+	std::cout << "-- " << size << " bytes, " << edits << " edits" << std::endl;
+	unsigned int		total = 0;
+	{
+		BenchTimer	timer("MString InsertAt/RemoveAt");
+		MString		str(text);
+		unsigned int cursor = size / 2;
+		for (int i = 0; i < edits; ++i)
+		{
+			if (i % 8 == 7)
+				str.RemoveAt(--cursor, 1);
+			else
+				str.InsertAt(cursor++, "k");
+			if (i % 500 == 0)
+				cursor -= 300;
+		}
+		total += str.Count();
+	}
+	{
+		BenchTimer	timer("MTextBuffer InsertAt/RemoveAt");
+		MTextBuffer	buffer(text);
+		unsigned int cursor = size / 2;
+		for (int i = 0; i < edits; ++i)
+		{
+			if (i % 8 == 7)
+				buffer.RemoveAt(--cursor, 1);
+			else
+				buffer.InsertAt(cursor++, 'k');
+			if (i % 500 == 0)
+				cursor -= 300;
+		}
+		total += buffer.ToString().Count();
+	}
+	std::cout << total << std::endl;
+}
+
+auto	BenchGlob() -> void
+{
+	const char*	rules[] = { "*.mesh", "**/*.mesh", "textures/**/diffuse_?.png", "textures/**/normal_?.png", "**/*.tmp", "shaders/*.hlsl",
+		"shaders/**/*.inc", "audio/**/*.wav", "audio/music/*.ogg", "levels/level_[0-9][0-9]/*.map", "**/.git/**", "**/thumbs.db",
+		"config/*.ini", "fonts/*.ttf", "scripts/**/*.lua", "docs/**" };
+	const char*	folders[] = { "textures/props/", "textures/", "shaders/", "shaders/common/", "audio/sfx/", "audio/music/", "levels/level_07/", "scripts/ai/", "" };
+	const char*	files[] = { "diffuse_a.png", "normal_b.png", "rock.mesh", "main.hlsl", "light.inc", "hit.wav", "theme.ogg", "arena.map", "brain.lua", "notes.txt" };
+	std::vector<std::string>	paths;
+	for (int idx = 0; idx < 100000; ++idx)
+		paths.push_back(std::string(folders[idx % 9]) + files[(idx / 9) % 10]);
+
+	MGlobSet			set;
+	std::vector<MGlob>	globs;
+	for (const char* rule : rules)
+	{
+		set.Add(rule);
+		globs.emplace_back(MStringView(rule));
+	}
+	std::cout << "-- " << paths.size() << " paths, " << set.RuleCount() << " rules" << std::endl;
+	unsigned int matched = 0;
+	{
+		BenchTimer	timer("MGlob one rule at a time");
+		for (std::string const& path : paths)
+		{
+			for (MGlob const& glob : globs)
+				matched += glob.Match(path);
+		}
+	}
+	{
+		BenchTimer	timer("MGlobSet::Match, NFA");
+		for (std::string const& path : paths)
+			set.Match(path, [&matched](unsigned int) { ++matched; return true; });
+	}
+	{
+		BenchTimer	timer("MGlobSet::Build");
+		set.Build();
+	}
+	std::cout << "-- " << set.StateCount() << " NFA states, DFA built: " << set.IsBuilt() << std::endl;
+	{
+		BenchTimer	timer("MGlobSet::Match, DFA");
+		for (std::string const& path : paths)
+			set.Match(path, [&matched](unsigned int) { ++matched; return true; });
+	}
+	std::cout << matched << std::endl;
+}
+
+auto	BenchSubstringIndex() -> void
+{
+	//Log like messages, searched for identifiers that appear a few times each
+	const unsigned int			messageCount = 200000;
+	const char*					words[] = { "entity", "spawned", "at", "position", "with", "handle", "loaded", "texture", "failed", "retry", "player", "zone" };
+	std::vector<MString>		messages;
+	MString						message;
+	for (unsigned int idx = 0; idx < messageCount; ++idx)
+	{
+		message.Empty();
+		for (unsigned int word = 0; word < 6; ++word)
+		{
+			message += words[(idx * 7 + word * 5 + idx / 13) % 12];
+			message += ' ';
+		}
+		message += "id_";
+		message.AppendUInt(idx * 2654435761u % 1000003);
+		messages.push_back(message);
+	}
+	std::vector<MString>		queries;
+	for (unsigned int idx = 0; idx < 200; ++idx)
+	{
+		message = "id_";
+		message.AppendUInt(idx * 7919 % 1000003);
+		queries.push_back(message);
+	}
+
+	MSubstringIndex				index;
+	for (MString const& text : messages)
+		index.AddDocument(text);
+	{
+		BenchTimer	timer("MSubstringIndex::Build");
+		index.Build(MSubstringIndex::AllThreads);
+	}
+	std::cout << "-- " << messageCount << " messages, " << queries.size() << " queries" << std::endl;
+	unsigned int found = 0;
+	{
+		BenchTimer	timer("MString::Contains over every message");
+		for (MString const& query : queries)
+		{
+			for (MString const& text : messages)
+				found += text.Contains(query);
+		}
+	}
+	{
+		BenchTimer	timer("MSubstringIndex::Count");
+		for (MString const& query : queries)
+			found += index.Count(query);
+	}
+	std::cout << found << std::endl;
+
+	{
+		BenchTimer	timer("MSubstringIndex::Save");
+		index.Save("bench_index.bin");
+	}
+	{
+		BenchTimer		timer("MSubstringIndex::Load + 200 queries");
+		MSubstringIndex	loaded;
+		loaded.Load("bench_index.bin");
+		for (MString const& query : queries)
+			found += loaded.Count(query);
+	}
+	std::cout << found << std::endl;
+	std::remove("bench_index.bin");
+}
+
+auto	BenchRadixTrie() -> void
+{
+	//Asset paths sharing long directory prefixes, looked up whole, by folder and by longest mount point
+	const char*	folders[] = { "data/textures/props/", "data/textures/characters/", "data/shaders/common/", "data/audio/sfx/", "data/levels/" };
+	std::vector<std::string>	paths;
+	for (int idx = 0; idx < 200000; ++idx)
+	{
+		char name[32];
+		std::snprintf(name, sizeof(name), "asset_%06d.bin", idx * 7919 % 1000003);
+		paths.push_back(std::string(folders[idx % 5]) + name);
+	}
+
+	std::map<std::string, int>	map;
+	MRadixTrie<int>				trie;
+	{
+		BenchTimer	timer("std::map insert");
+		for (int idx = 0; idx < (int)paths.size(); ++idx)
+			map[paths[idx]] = idx;
+	}
+	{
+		BenchTimer	timer("MRadixTrie::Insert");
+		for (int idx = 0; idx < (int)paths.size(); ++idx)
+			trie.Insert(paths[idx], idx);
+	}
+	std::cout << "-- " << trie.Count() << " keys, " << trie.NodeCount() << " nodes, " << trie.MemoryUsage() / 1024 << " KB" << std::endl;
+
+	long long sum = 0;
+	{
+		BenchTimer	timer("std::map find");
+		for (std::string const& path : paths)
+			sum += map.find(path)->second;
+	}
+	{
+		BenchTimer	timer("MRadixTrie::Find");
+		for (std::string const& path : paths)
+			sum += *trie.Find(path);
+	}
+	std::cout << sum << std::endl;
+
+	std::string	prefix = "data/textures/props/asset_01";
+	unsigned int found = 0;
+	{
+		BenchTimer	timer("std::map lower_bound scan x1000");
+		for (int round = 0; round < 1000; ++round)
+		{
+			for (auto it = map.lower_bound(prefix); it != map.end() && it->first.compare(0, prefix.size(), prefix) == 0; ++it)
+				++found;
+		}
+	}
+	{
+		BenchTimer	timer("MRadixTrie::ForEachPrefixed x1000");
+		for (int round = 0; round < 1000; ++round)
+			trie.ForEachPrefixed(prefix, [&found](MStringView, int const&) { ++found; return true; });
+	}
+	std::cout << found << std::endl;
+
+	MRadixTrie<int>	mounts;
+	for (int idx = 0; idx < 5; ++idx)
+		mounts.Insert(folders[idx], idx);
+	mounts.Insert("data/", 5);
+	{
+		BenchTimer	timer("MRadixTrie::LongestPrefix");
+		for (std::string const& path : paths)
+			sum += *mounts.LongestPrefix(path);
+	}
+	std::cout << sum << std::endl;
+}
+
+auto	BenchStringTable() -> void
+{
+	//Name table written as text, one name per line, then read back at startup
+	const unsigned int	nameCount = 300000;
+	{
+		std::ofstream	out("bench_names.txt", std::ios::binary);
+		char			name[48];
+		for (unsigned int idx = 0; idx < nameCount; ++idx)
+		{
+			std::snprintf(name, sizeof(name), "entities/props/prop_%07u.mesh\n", idx * 2654435761u % 10000019);
+			out << name;
+		}
+	}
+	std::vector<MString>	queries;
+	for (unsigned int idx = 0; idx < 1000; ++idx)
+	{
+		char name[48];
+		std::snprintf(name, sizeof(name), "entities/props/prop_%07u.mesh", idx * 97 * 2654435761u % 10000019);
+		queries.push_back(name);
+	}
+
+	unsigned int found = 0;
+	{
+		BenchTimer										timer("Parse text into MString + unordered_map");
+		MMappedFile										file("bench_names.txt");
+		std::vector<MString>							names;
+		std::unordered_map<MStringView, unsigned int>	ids;
+		for (MStringView line : file.Lines())
+			names.emplace_back(line);
+		for (unsigned int idx = 0; idx < names.size(); ++idx)
+			ids.emplace(names[idx], idx);
+		for (MString const& query : queries)
+			found += ids.count(query) != 0;
+	}
+	{
+		BenchTimer		timer("Parse text into MStringTable + Save");
+		MMappedFile		file("bench_names.txt");
+		MStringTable	table;
+		for (MStringView line : file.Lines())
+			table.Add(line);
+		table.Save("bench_names.bin");
+	}
+	{
+		BenchTimer		timer("MStringTable::Load + 1000 Find");
+		MStringTable	table;
+		table.Load("bench_names.bin");
+		for (MString const& query : queries)
+			found += table.Contains(query);
+	}
+	std::cout << found << std::endl;
+	std::remove("bench_names.txt");
+	std::remove("bench_names.bin");
+}
@@ -0,0 +1,24 @@
+#ifndef __BENCHMARK_HPP__
+#define __BENCHMARK_HPP__
+
+auto	BenchStringAllocations() -> void;
+auto	BenchStringAppend() -> void;
+auto	BenchStringBuilder() -> void;
+auto	BenchStringSearch() -> void;
+auto	BenchStringNumbers() -> void;
+auto	BenchStringHash() -> void;
+auto	BenchStringArena() -> void;
+auto	BenchStringCopy() -> void;
+auto	BenchStringUTF() -> void;
+auto	BenchStringMatcher() -> void;
+auto	BenchStringFormat() -> void;
+auto	BenchStringReplace() -> void;
+auto	BenchStringSort() -> void;
+auto	BenchMappedFile() -> void;
+auto	BenchTextBuffer() -> void;
+auto	BenchGlob() -> void;
+auto	BenchSubstringIndex() -> void;
+auto	BenchRadixTrie() -> void;
+auto	BenchStringTable() -> void;
+
+#endif /*__BENCHMARK_HPP__*/
@@ -1,4 +1,5 @@
 #include "../MUtils/String.hpp"
+#include "Benchmark.hpp"
 
 #include <iostream>
 
@@ -33,6 +34,26 @@ void main()
 	finalStr.InsertAt(5, MString("Margoulin"));
 	LOG(finalStr.Str());
 
+	BenchStringAllocations();
+	BenchStringAppend();
+	BenchStringBuilder();
+	BenchStringSearch();
+	BenchStringNumbers();
+	BenchStringHash();
+	BenchStringArena();
+	BenchStringCopy();
+	BenchStringUTF();
+	BenchStringMatcher();
+	BenchStringFormat();
+	BenchStringReplace();
+	BenchStringSort();
+	BenchMappedFile();
+	BenchTextBuffer();
+	BenchGlob();
+	BenchSubstringIndex();
+	BenchRadixTrie();
+	BenchStringTable();
+
 	while (true)
 	{ }
 }
\ No newline at end of file